@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+struct benchmark {
+  const char *name;
+  void (*run)();
+};
+
+inline std::vector<benchmark> &registry() {
+  static std::vector<benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct registrar {
+  registrar(const char *name, void (*run)()) {
+    registry().push_back({name, run});
+  }
+};
+
+#define BENCHMARK(name)                                                        \
+  static void name();                                                          \
+  static bench::registrar name##_registrar(#name, name);                       \
+  static void name()
+
+/**
+ * @brief Keep the compiler from optimizing away a computed value.
+ */
+template <typename T> inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T *sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * @brief Hardware counters read with `perf_event_open` around each run. The
+ * events form one group led by the cycle counter, so the kernel schedules
+ * them together and they cover the same time window. They count the calling
+ * thread only (`inherit` is 0), so work done on other threads is missed. In
+ * containers and on systems that forbid perf events the counters cannot be
+ * opened, and the benchmarks report time only.
+ */
+class perf_counters {
+public:
+  static constexpr size_t count = 4;
+
+  perf_counters() {
+#if defined(__linux__)
+    const uint64_t l1_read_miss =
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    fds[0] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (fds[0] < 0) {
+      failure = errno;
+      return;
+    }
+    fds[1] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, fds[0]);
+    fds[2] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, fds[0]);
+    fds[3] = open(PERF_TYPE_HW_CACHE, l1_read_miss, fds[0]);
+#endif
+  }
+
+  perf_counters(const perf_counters &) = delete;
+  perf_counters &operator=(const perf_counters &) = delete;
+
+  ~perf_counters() {
+#if defined(__linux__)
+    // Members first, then the group leader.
+    for (size_t i = count; i-- > 0;) {
+      if (fds[i] >= 0) {
+        ::close(fds[i]);
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief Whether at least the cycle counter could be opened.
+   */
+  bool is_available() const { return fds[0] >= 0; }
+
+  /**
+   * @brief The `errno` value of the failed attempt to open the cycle counter.
+   */
+  int error() const { return failure; }
+
+  void start() {
+#if defined(__linux__)
+    ::ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+  }
+
+  /**
+   * @brief Stop counting and store the counts, or -1 for the counters that
+   * are unavailable. When the kernel multiplexed the group with other events
+   * the counts are scaled up to the whole run and `is_scaled` is set; when
+   * the group never ran every count is -1.
+   */
+  void stop(int64_t (&values)[count], bool &is_scaled) {
+    std::fill(values, values + count, -1);
+    is_scaled = false;
+#if defined(__linux__)
+    ::ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    // { nr, time_enabled, time_running, value[nr] } in the order the events
+    // joined the group.
+    uint64_t data[3 + count];
+    ssize_t size = ::read(fds[0], data, sizeof(data));
+    if (size < static_cast<ssize_t>(3 * sizeof(uint64_t)) || data[2] == 0) {
+      return;
+    }
+    uint64_t enabled = data[1];
+    uint64_t running = data[2];
+    is_scaled = running < enabled;
+    size_t k = 0;
+    for (size_t i = 0; i < count && k < data[0]; i++) {
+      if (fds[i] < 0) {
+        continue;
+      }
+      double value = static_cast<double>(data[3 + k++]);
+      if (is_scaled) {
+        value = value * static_cast<double>(enabled) /
+                static_cast<double>(running);
+      }
+      values[i] = static_cast<int64_t>(value);
+    }
+#endif
+  }
+
+private:
+#if defined(__linux__)
+  static int open(uint32_t type, uint64_t config, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Only the leader starts disabled; the members follow it.
+    attr.disabled = group_fd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1,
+                                      group_fd, 0));
+  }
+#endif
+
+  int fds[count] = {-1, -1, -1, -1};
+  int failure = 0;
+};
+
+/**
+ * @brief The state of the perf mode, enabled with `--perf` on the command
+ * line.
+ */
+struct perf_state {
+  bool is_enabled = false;
+  perf_counters *counters = nullptr;
+  // The counts of the fastest run of the last `measure`, or -1.
+  int64_t best[perf_counters::count] = {-1, -1, -1, -1};
+  // Whether those counts were scaled up from a multiplexed run.
+  bool is_best_scaled = false;
+};
+
+inline perf_state &perf() {
+  static perf_state state;
+  return state;
+}
+
+/**
+ * @brief Open the hardware counters for the following benchmarks. Returns
+ * false, after printing why, when they are unavailable.
+ */
+inline bool enable_perf_counters() {
+  static perf_counters counters;
+  if (!counters.is_available()) {
+    std::printf("hardware counters unavailable (%s); reporting time only\n",
+                std::strerror(counters.error()));
+    return false;
+  }
+  std::printf("hardware counters count the calling thread only; parallel "
+              "benchmarks undercount\n");
+  perf().is_enabled = true;
+  perf().counters = &counters;
+  return true;
+}
+
+/**
+ * @brief Returns the best wall-clock time in seconds over several runs. In
+ * perf mode the hardware counts of that run are kept for `report`.
+ */
+template <typename F> inline double measure(F &&f, int repeats = 5) {
+  perf_state &state = perf();
+  std::fill(state.best, state.best + perf_counters::count, -1);
+  state.is_best_scaled = false;
+  double best = 1e300;
+  for (int i = 0; i < repeats; i++) {
+    if (state.is_enabled) {
+      state.counters->start();
+    }
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    int64_t counts[perf_counters::count];
+    bool is_scaled = false;
+    if (state.is_enabled) {
+      state.counters->stop(counts, is_scaled);
+    }
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    if (seconds < best) {
+      best = seconds;
+      if (state.is_enabled) {
+        std::copy(counts, counts + perf_counters::count, state.best);
+        state.is_best_scaled = is_scaled;
+      }
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Print one result line: time per value and throughput of `bytes`,
+ * followed in perf mode by cycles per value, instructions per cycle, and
+ * branch and L1 data cache misses per value. Counts scaled up from a
+ * multiplexed run are marked as such.
+ */
+inline void report(const std::string &name, double seconds, size_t values,
+                   size_t bytes) {
+  std::printf("%-48s %8.3f ns/value %8.2f GB/s", name.c_str(),
+              seconds * 1e9 / static_cast<double>(values),
+              static_cast<double>(bytes) / seconds / 1e9);
+  const int64_t *counts = perf().best;
+  auto per_value = [&](int64_t count) {
+    return static_cast<double>(count) / static_cast<double>(values);
+  };
+  if (counts[0] > 0) {
+    std::printf(" %8.2f cycles/value", per_value(counts[0]));
+  }
+  if (counts[0] > 0 && counts[1] >= 0) {
+    std::printf(" %5.2f IPC", static_cast<double>(counts[1]) /
+                                  static_cast<double>(counts[0]));
+  }
+  if (counts[2] >= 0) {
+    std::printf(" %7.4f br-miss/value", per_value(counts[2]));
+  }
+  if (counts[3] >= 0) {
+    std::printf(" %7.4f L1-miss/value", per_value(counts[3]));
+  }
+  if (perf().is_best_scaled) {
+    std::printf(" (multiplexed, scaled)");
+  }
+  std::printf("\n");
+}
+
+}; // namespace bench
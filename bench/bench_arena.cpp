@@ -0,0 +1,43 @@
+#include "bench.hpp"
+#include "bit_converter/arena.hpp"
+#include "bit_converter/bit_converter.hpp"
+
+using std::vector;
+
+namespace {
+
+template <typename Buffer> void encode_message(Buffer &buffer, size_t i) {
+  auto output = std::back_inserter(buffer);
+  output = bit_converter::u32_to_bytes(22, true, output);
+  output = bit_converter::u16_to_bytes(7, true, output);
+  output = bit_converter::i64_to_bytes(static_cast<int64_t>(i), true, output);
+  bit_converter::f64_to_bytes(static_cast<double>(i) * 0.25, true, output);
+}
+
+} // namespace
+
+BENCHMARK(arena_messages) {
+  const size_t count = 1 << 20;
+  double seconds = bench::measure([&] {
+    for (size_t i = 0; i < count; i++) {
+      vector<uint8_t> buffer;
+      encode_message(buffer, i);
+      bench::do_not_optimize(buffer.data());
+    }
+  });
+  bench::report("std::vector per message", seconds, count, count * 22);
+
+  bit_converter::byte_arena arena;
+  seconds = bench::measure([&] {
+    for (size_t i = 0; i < count; i++) {
+      if (i % 4096 == 0) {
+        arena.reset();
+      }
+      bit_converter::arena_buffer buffer(arena, 32);
+      encode_message(buffer, i);
+      buffer.shrink_to_fit();
+      bench::do_not_optimize(buffer.data());
+    }
+  });
+  bench::report("arena_buffer per message", seconds, count, count * 22);
+}
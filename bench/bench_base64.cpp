@@ -0,0 +1,106 @@
+#include "bench.hpp"
+#include "bit_converter/base64.hpp"
+#include "bit_converter/bit_converter.hpp"
+
+using std::vector;
+
+namespace {
+
+/**
+ * @brief Encode one byte at a time, as the routine this replaces did.
+ */
+char *bytewise_base64(const uint8_t *data, size_t size, char *output) {
+  static const char digits[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  uint32_t bits = 0;
+  int pending = 0;
+  for (size_t i = 0; i < size; i++) {
+    bits = bits << 8 | data[i];
+    pending += 8;
+    while (pending >= 6) {
+      pending -= 6;
+      *output++ = digits[(bits >> pending) & 0x3F];
+    }
+  }
+  if (pending > 0) {
+    *output++ = digits[(bits << (6 - pending)) & 0x3F];
+    *output++ = '=';
+    if (pending == 2) {
+      *output++ = '=';
+    }
+  }
+  return output;
+}
+
+} // namespace
+
+BENCHMARK(base64) {
+  const size_t count = 1 << 19;
+  const size_t size = count * 8;
+  vector<int64_t> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = static_cast<int64_t>(i * 0x9E3779B97F4A7C15ULL);
+  }
+  vector<uint8_t> bytes(size);
+  vector<char> text(bit_converter::base64_size(size));
+  vector<uint8_t> decoded(size);
+  bit_converter::values_to_bytes(values.data(), count, true, bytes.data());
+
+  double seconds = bench::measure([&] {
+    bytewise_base64(bytes.data(), size, text.data());
+    bench::do_not_optimize(text.data());
+  });
+  bench::report("byte-at-a-time encode", seconds, count, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::detail::bytes_to_base64_scalar(
+        bytes.data(), size, text.data(),
+        bit_converter::detail::base64_lookup(false));
+    bench::do_not_optimize(text.data());
+  });
+  bench::report("bytes_to_base64 scalar", seconds, count, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::bytes_to_base64(bytes.data(), size, text.data());
+    bench::do_not_optimize(text.data());
+  });
+  bench::report("bytes_to_base64", seconds, count, size);
+
+  bool valid = true;
+  seconds = bench::measure([&] {
+    valid &= bit_converter::detail::base64_to_bytes_scalar(
+        text.data(), text.size() / 4, decoded.data(),
+        bit_converter::detail::base64_lookup(false).values);
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report("base64_to_bytes scalar", seconds, count, size);
+
+  seconds = bench::measure([&] {
+    valid &= bit_converter::base64_to_bytes(text.data(), text.size(),
+                                            decoded.data());
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report("base64_to_bytes", seconds, count, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::values_to_bytes(values.data(), count, true, bytes.data());
+    bit_converter::bytes_to_base64(bytes.data(), size, text.data());
+    bench::do_not_optimize(text.data());
+  });
+  bench::report("values_to_bytes + bytes_to_base64", seconds, count, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::values_to_base64(values.data(), count, true, text.data());
+    bench::do_not_optimize(text.data());
+  });
+  bench::report("values_to_base64", seconds, count, size);
+
+  vector<int64_t> results(count);
+  seconds = bench::measure([&] {
+    valid &= bit_converter::base64_to_values(text.data(), text.size(),
+                                             results.data(), count, true);
+    bench::do_not_optimize(results.data());
+  });
+  bench::report("base64_to_values", seconds, count, size);
+  bench::do_not_optimize(valid);
+}
@@ -0,0 +1,67 @@
+#include "bench.hpp"
+#include "bit_converter/bit_converter.hpp"
+
+#include <memory>
+
+using std::vector;
+
+BENCHMARK(bitmap) {
+  const size_t bit_count = 1 << 24;
+  const size_t size = bit_count / 8;
+  vector<bool> bits(bit_count);
+  std::unique_ptr<bool[]> array(new bool[bit_count]);
+  for (size_t i = 0; i < bit_count; i++) {
+    array[i] = (i * 0x9E3779B97F4A7C15ULL >> 63) != 0;
+    bits[i] = array[i];
+  }
+  vector<uint8_t> bytes(size);
+
+  double seconds = bench::measure([&] {
+    // The proxy-bit loop used where no word access is available.
+    uint8_t *output = bytes.data();
+    auto it = bits.begin();
+    for (size_t i = 0; i < size; i++) {
+      uint8_t b = 0;
+      for (int j = 0; j < 8; j++, ++it) {
+        b |= static_cast<uint8_t>(*it) << j;
+      }
+      output[i] = b;
+    }
+    bench::do_not_optimize(bytes.data());
+  });
+  bench::report("vector<bool> proxy bits", seconds, bit_count, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::create_bytes_from_bits(bits, bytes.data());
+    bench::do_not_optimize(bytes.data());
+  });
+  bench::report("create_bytes_from_bits", seconds, bit_count, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::bits_to_bytes(bits, true, bytes.data());
+    bench::do_not_optimize(bytes.data());
+  });
+  bench::report("bits_to_bytes vector<bool>", seconds, bit_count, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::bits_to_bytes(array.get(), bit_count, true, bytes.data());
+    bench::do_not_optimize(bytes.data());
+  });
+  bench::report("bits_to_bytes bool array", seconds, bit_count, size);
+
+  vector<bool> decoded;
+  seconds = bench::measure([&] {
+    decoded = bit_converter::bytes_to_bits(bytes.data(), bit_count, true);
+    bench::do_not_optimize(decoded);
+  });
+  if (decoded != bits) {
+    std::printf("bytes_to_bits: round trip mismatch\n");
+  }
+  bench::report("bytes_to_bits vector<bool>", seconds, bit_count, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::bytes_to_bits(bytes.data(), bit_count, true, array.get());
+    bench::do_not_optimize(array.get());
+  });
+  bench::report("bytes_to_bits bool array", seconds, bit_count, size);
+}
@@ -0,0 +1,83 @@
+#include "bench.hpp"
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/crc32c.hpp"
+
+using std::vector;
+
+BENCHMARK(crc32c) {
+  const size_t count = 1 << 20;
+  vector<int64_t> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = static_cast<int64_t>(i * 0x9E3779B97F4A7C15ULL);
+  }
+  vector<uint8_t> frame(count * 8);
+  uint32_t crc = 0;
+
+  double seconds = bench::measure([&] {
+    crc = bit_converter::detail::crc32c_update_table(0xFFFFFFFF, frame.data(),
+                                                     frame.size());
+    bench::do_not_optimize(crc);
+  });
+  bench::report("crc32c slice-by-8", seconds, count, frame.size());
+
+  seconds = bench::measure([&] {
+    crc = bit_converter::crc32c(frame.data(), frame.size());
+    bench::do_not_optimize(crc);
+  });
+  bench::report("crc32c", seconds, count, frame.size());
+
+  seconds = bench::measure([&] {
+    for (size_t i = 0; i < count; i++) {
+      bit_converter::i64_to_bytes(values[i], true, frame.data() + i * 8);
+    }
+    crc = bit_converter::crc32c(frame.data(), frame.size());
+    bench::do_not_optimize(crc);
+  });
+  bench::report("i64_to_bytes + crc32c pass", seconds, count, frame.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::crc32c_writer writer(frame.data());
+    for (size_t i = 0; i < count; i++) {
+      writer.write_value(values[i], true);
+    }
+    crc = writer.checksum();
+    bench::do_not_optimize(crc);
+  });
+  bench::report("crc32c_writer::write_value", seconds, count, frame.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::values_to_bytes(values.data(), count, true, frame.data());
+    crc = bit_converter::crc32c(frame.data(), frame.size());
+    bench::do_not_optimize(crc);
+  });
+  bench::report("values_to_bytes + crc32c pass", seconds, count,
+                frame.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::crc32c_writer writer(frame.data());
+    writer.write_values(values.data(), count, true);
+    crc = writer.checksum();
+    bench::do_not_optimize(crc);
+  });
+  bench::report("crc32c_writer::write_values", seconds, count, frame.size());
+
+  vector<int64_t> decoded(count);
+  seconds = bench::measure([&] {
+    crc = bit_converter::crc32c(frame.data(), frame.size());
+    bit_converter::bytes_to_values(static_cast<const uint8_t *>(frame.data()),
+                                   count, true, decoded.data());
+    bench::do_not_optimize(decoded.data());
+    bench::do_not_optimize(crc);
+  });
+  bench::report("crc32c pass + bytes_to_values", seconds, count,
+                frame.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::crc32c_reader reader(frame.data(), frame.size());
+    reader.read_values(decoded.data(), count, true);
+    crc = reader.checksum();
+    bench::do_not_optimize(decoded.data());
+    bench::do_not_optimize(crc);
+  });
+  bench::report("crc32c_reader::read_values", seconds, count, frame.size());
+}
@@ -0,0 +1,100 @@
+#include "bench.hpp"
+#include "bit_converter/delta.hpp"
+
+#include <random>
+
+using std::vector;
+
+namespace {
+
+/**
+ * @brief Millisecond timestamps sampled about once a second with jitter and
+ * an occasional gap, like a typical metrics scrape.
+ */
+vector<int64_t> make_timestamps(size_t count) {
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<int64_t> jitter(-3, 3);
+  std::uniform_int_distribution<int> gap(0, 999);
+  vector<int64_t> timestamps(count);
+  int64_t t = 1618000000000LL;
+  for (size_t i = 0; i < count; i++) {
+    t += 1000 + jitter(random) + (gap(random) == 0 ? 60000 : 0);
+    timestamps[i] = t;
+  }
+  return timestamps;
+}
+
+template <typename Encode, typename Decode>
+void run(const char *name, const vector<int64_t> &timestamps, Encode encode,
+         Decode decode) {
+  vector<uint8_t> bytes(timestamps.size() * bit_converter::max_varint_size);
+  size_t size = static_cast<size_t>(
+      encode(timestamps.data(), timestamps.size(), bytes.data()) -
+      bytes.data());
+  vector<int64_t> decoded(timestamps.size());
+  double seconds = bench::measure([&] {
+    decode(bytes.data(), decoded.size(), decoded.data());
+    bench::do_not_optimize(decoded.data());
+  });
+  if (decoded != timestamps) {
+    std::printf("%s: round trip mismatch\n", name);
+  }
+  std::printf("%-48s %8.3f bytes/value\n", name,
+              static_cast<double>(size) /
+                  static_cast<double>(timestamps.size()));
+  bench::report(std::string(name) + " decode", seconds, timestamps.size(),
+                timestamps.size() * sizeof(int64_t));
+}
+
+} // namespace
+
+BENCHMARK(delta_timestamps) {
+  const auto timestamps = make_timestamps(1 << 22);
+  run(
+      "i64_to_bytes", timestamps,
+      [](const int64_t *values, size_t count, uint8_t *output) {
+        for (size_t i = 0; i < count; i++) {
+          output = bit_converter::i64_to_bytes(values[i], true, output);
+        }
+        return output;
+      },
+      [](const uint8_t *input, size_t count, int64_t *values) {
+        for (size_t i = 0; i < count; i++) {
+          values[i] = bit_converter::bytes_to_i64(input + i * 8, true);
+        }
+      });
+  run(
+      "delta_to_bytes", timestamps,
+      [](const int64_t *values, size_t count, uint8_t *output) {
+        return bit_converter::delta_to_bytes(values, count, true, output);
+      },
+      [](const uint8_t *input, size_t count, int64_t *values) {
+        bit_converter::bytes_to_delta(input, count, true, values);
+      });
+  run(
+      "delta_to_varints", timestamps,
+      [](const int64_t *values, size_t count, uint8_t *output) {
+        return bit_converter::delta_to_varints(values, count, output);
+      },
+      [](const uint8_t *input, size_t count, int64_t *values) {
+        bit_converter::varints_to_delta(input, count, values);
+      });
+  run(
+      "delta_of_delta_to_varints", timestamps,
+      [](const int64_t *values, size_t count, uint8_t *output) {
+        return bit_converter::delta_of_delta_to_varints(values, count, output);
+      },
+      [](const uint8_t *input, size_t count, int64_t *values) {
+        bit_converter::varints_to_delta_of_delta(input, count, values);
+      });
+  vector<int64_t> deltas(timestamps.size());
+  bit_converter::delta_encode(timestamps.data(), timestamps.size(),
+                              deltas.data());
+  vector<int64_t> decoded(timestamps.size());
+  double seconds = bench::measure([&] {
+    bit_converter::delta_decode(deltas.data(), deltas.size(), decoded.data());
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report("delta_decode (prefix sum only)", seconds, deltas.size(),
+                deltas.size() * sizeof(int64_t));
+}
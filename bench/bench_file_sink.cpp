@@ -0,0 +1,33 @@
+#include "bench.hpp"
+#include "bit_converter/file_sink.hpp"
+
+#include <cstdio>
+
+using std::vector;
+
+BENCHMARK(file_sink) {
+  const size_t count = 1 << 22;
+  const char *path = "bench_file_sink.bin";
+  vector<double> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = static_cast<double>(i) * 0.5;
+  }
+
+  double seconds = bench::measure([&] {
+    vector<uint8_t> bytes(count * sizeof(double));
+    bit_converter::values_to_bytes(values.data(), count, true, bytes.data());
+    FILE *file = std::fopen(path, "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+  });
+  bench::report("vector + fwrite", seconds, count, count * sizeof(double));
+
+  seconds = bench::measure([&] {
+    bit_converter::file_sink sink(path);
+    sink.write_values(values.data(), count, true);
+    sink.close();
+  });
+  bench::report("file_sink", seconds, count, count * sizeof(double));
+
+  std::remove(path);
+}
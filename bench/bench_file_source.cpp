@@ -0,0 +1,55 @@
+#include "bench.hpp"
+#include "bit_converter/file_source.hpp"
+
+#include <cstdio>
+
+using std::vector;
+
+BENCHMARK(file_source) {
+  const size_t count = 1 << 23;
+  const char *path = "bench_file_source.bin";
+  {
+    vector<uint8_t> bytes(count * sizeof(double));
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 131);
+    }
+    FILE *file = std::fopen(path, "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+  }
+
+  double seconds = bench::measure([&] {
+    FILE *file = std::fopen(path, "rb");
+    vector<uint8_t> block(1 << 20);
+    vector<double> values(block.size() / sizeof(double));
+    size_t size;
+    while ((size = std::fread(block.data(), 1, block.size(), file)) > 0) {
+      bit_converter::bytes_to_values(block.data(), size / sizeof(double), true,
+                                     values.data());
+      bench::do_not_optimize(values.data());
+    }
+    std::fclose(file);
+  });
+  bench::report("fread + bytes_to_values", seconds, count,
+                count * sizeof(double));
+
+  for (bool use_io_uring : {false, true}) {
+    bit_converter::file_source::options config;
+    config.use_io_uring = use_io_uring;
+    bool is_using_io_uring = false;
+    seconds = bench::measure([&] {
+      bit_converter::file_decoder<double> decoder(path, true, config);
+      is_using_io_uring = decoder.is_using_io_uring();
+      const double *values;
+      size_t n;
+      while (decoder.next_batch(values, n)) {
+        bench::do_not_optimize(values);
+      }
+    });
+    bench::report(is_using_io_uring ? "file_decoder (io_uring)"
+                                     : "file_decoder (pread threads)",
+                  seconds, count, count * sizeof(double));
+  }
+
+  std::remove(path);
+}
@@ -0,0 +1,54 @@
+#include "bench.hpp"
+#include "bit_converter/filter.hpp"
+
+using std::vector;
+
+namespace {
+
+template <typename T> void bench_filter(const char *name) {
+  const size_t count = 1 << 23;
+  vector<T> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = static_cast<T>((i * 2654435761U) % 1000);
+  }
+  vector<uint8_t> bytes(count * sizeof(T));
+  bit_converter::values_to_bytes(values.data(), count, true, bytes.data());
+  bit_converter::predicate<T> where{bit_converter::comparison::between, 100,
+                                    400};
+  vector<uint8_t> bitmap(count / 8);
+
+  vector<T> decoded(count);
+  double seconds = bench::measure([&] {
+    bit_converter::bytes_to_values(static_cast<const uint8_t *>(bytes.data()),
+                                   count, true, decoded.data());
+    for (size_t i = 0; i < count; i += 8) {
+      uint8_t bits = 0;
+      for (size_t k = 0; k < 8; k++) {
+        bits |= static_cast<uint8_t>(
+            (decoded[i + k] >= where.value && decoded[i + k] <= where.upper)
+            << k);
+      }
+      bitmap[i / 8] = bits;
+    }
+    bench::do_not_optimize(bitmap.data());
+  });
+  bench::report(std::string(name) + " bytes_to_values + loop", seconds, count,
+                bytes.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::filter_to_bitmap(bytes.data(), count, true, where,
+                                    bitmap.data());
+    bench::do_not_optimize(bitmap.data());
+  });
+  bench::report(std::string(name) + " filter_to_bitmap", seconds, count,
+                bytes.size());
+}
+
+} // namespace
+
+BENCHMARK(filter) {
+  bench_filter<int32_t>("i32");
+  bench_filter<int64_t>("i64");
+  bench_filter<float>("f32");
+  bench_filter<double>("f64");
+}
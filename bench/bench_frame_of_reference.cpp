@@ -0,0 +1,51 @@
+#include "bench.hpp"
+#include "bit_converter/frame_of_reference.hpp"
+
+#include <random>
+
+using std::vector;
+
+BENCHMARK(frame_of_reference_i32) {
+  const size_t count = 1 << 22;
+  std::mt19937 random(42);
+  vector<int32_t> values(count);
+  for (int width : {4, 12, 20, 31}) {
+    std::uniform_int_distribution<int32_t> residual(0, (1 << width) - 1);
+    for (size_t i = 0; i < count; i++) {
+      values[i] = 100000 + residual(random);
+    }
+    vector<uint8_t> bytes(
+        bit_converter::frame_of_reference_max_size<int32_t>(count));
+    size_t size = static_cast<size_t>(
+        bit_converter::frame_of_reference_to_bytes(values.data(), count, true,
+                                                   bytes.data()) -
+        bytes.data());
+    vector<int32_t> decoded(count);
+    double seconds = bench::measure([&] {
+      bit_converter::bytes_to_frame_of_reference(
+          static_cast<const uint8_t *>(bytes.data()), count, true,
+          decoded.data());
+      bench::do_not_optimize(decoded.data());
+    });
+    if (decoded != values) {
+      std::printf("round trip mismatch\n");
+    }
+    std::string name = "residual width " + std::to_string(width);
+    std::printf("%-48s %8.3f bytes/value\n", name.c_str(),
+                static_cast<double>(size) / static_cast<double>(count));
+    bench::report(name + " decode", seconds, count, count * sizeof(int32_t));
+  }
+
+  vector<uint8_t> raw(count * sizeof(int32_t));
+  for (size_t i = 0; i < count; i++) {
+    bit_converter::i32_to_bytes(values[i], true, raw.begin() + i * 4);
+  }
+  vector<int32_t> decoded(count);
+  double seconds = bench::measure([&] {
+    for (size_t i = 0; i < count; i++) {
+      decoded[i] = bit_converter::bytes_to_i32(raw.data() + i * 4, true);
+    }
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report("bytes_to_i32 decode", seconds, count, count * sizeof(int32_t));
+}
@@ -0,0 +1,65 @@
+#include "bench.hpp"
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/gather.hpp"
+
+using std::vector;
+
+namespace {
+
+/**
+ * @brief Decode `lookups` random positions of a buffer of `size` values,
+ * one `bytes_to_*` call at a time and with `gather_values`.
+ */
+template <typename T, typename Decode>
+void bench_gather(const char *name, size_t size, Decode decode) {
+  const size_t lookups = 1 << 22;
+  vector<uint8_t> bytes(size * sizeof(T));
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<uint8_t>(i * 131);
+  }
+  vector<uint32_t> indices(lookups);
+  uint64_t state = 88172645463325252ULL;
+  for (uint32_t &index : indices) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    index = static_cast<uint32_t>(state % size);
+  }
+  vector<T> values(lookups);
+
+  double seconds = bench::measure([&] {
+    for (size_t i = 0; i < lookups; i++) {
+      values[i] = decode(bytes.data() + indices[i] * sizeof(T));
+    }
+    bench::do_not_optimize(values.data());
+  });
+  bench::report(std::string(name) + " bytes_to_* loop", seconds, lookups,
+                lookups * sizeof(T));
+
+  seconds = bench::measure([&] {
+    bit_converter::gather_values(bytes.data(), indices.data(), lookups, true,
+                                 values.data());
+    bench::do_not_optimize(values.data());
+  });
+  bench::report(std::string(name) + " gather_values", seconds, lookups,
+                lookups * sizeof(T));
+}
+
+} // namespace
+
+BENCHMARK(gather) {
+  // 512 MiB, well beyond the last-level cache.
+  const size_t large = size_t(1) << 26;
+  // 256 KiB, which stays in L2.
+  const size_t small = size_t(1) << 15;
+  auto u64 = [](const uint8_t *at) {
+    return bit_converter::bytes_to_u64(at, true);
+  };
+  auto i32 = [](const uint8_t *at) {
+    return bit_converter::bytes_to_i32(at, true);
+  };
+  bench_gather<uint64_t>("u64 512 MiB", large, u64);
+  bench_gather<int32_t>("i32 256 MiB", large, i32);
+  bench_gather<uint64_t>("u64 256 KiB", small, u64);
+  bench_gather<int32_t>("i32 128 KiB", small, i32);
+}
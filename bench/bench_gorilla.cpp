@@ -0,0 +1,73 @@
+#include "bench.hpp"
+#include "bit_converter/gorilla.hpp"
+
+#include <cmath>
+#include <random>
+
+using std::vector;
+
+namespace {
+
+void run(const std::string &name, const vector<double> &values) {
+  vector<uint8_t> bytes;
+  bit_converter::f64_to_gorilla(values.data(), values.size(),
+                                std::back_inserter(bytes));
+  vector<double> decoded(values.size());
+  double seconds = bench::measure([&] {
+    bit_converter::gorilla_to_f64(bytes.data(), bytes.size(), decoded.size(),
+                                  decoded.data());
+    bench::do_not_optimize(decoded.data());
+  });
+  std::printf("%-48s %8.2f x compression\n", name.c_str(),
+              static_cast<double>(values.size() * sizeof(double)) /
+                  static_cast<double>(bytes.size()));
+  bench::report(name + " decode", seconds, values.size(),
+                values.size() * sizeof(double));
+}
+
+} // namespace
+
+BENCHMARK(gorilla_f64) {
+  const size_t count = 1 << 21;
+  std::mt19937_64 random(42);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  std::uniform_int_distribution<int> event(0, 99);
+
+  // A thermometer with 0.1 degree resolution that rarely changes.
+  vector<double> temperature(count);
+  double t = 21.5;
+  for (size_t i = 0; i < count; i++) {
+    t += event(random) < 5 ? (noise(random) > 0 ? 0.1 : -0.1) : 0.0;
+    temperature[i] = std::round(t * 10) / 10;
+  }
+  run("temperature, 0.1 resolution", temperature);
+
+  // A gauge that stays flat for long stretches, like a CPU quota.
+  vector<double> gauge(count);
+  double level = 100;
+  for (size_t i = 0; i < count; i++) {
+    level = event(random) == 0 ? std::round(noise(random) * 10 + 100) : level;
+    gauge[i] = level;
+  }
+  run("step gauge", gauge);
+
+  // Full-precision noisy measurements: the worst case for XOR compression.
+  vector<double> noisy(count);
+  for (size_t i = 0; i < count; i++) {
+    noisy[i] = 1000 + noise(random);
+  }
+  run("full-precision noise", noisy);
+
+  vector<uint8_t> raw(count * sizeof(double));
+  for (size_t i = 0; i < count; i++) {
+    bit_converter::f64_to_bytes(temperature[i], false, raw.data() + i * 8);
+  }
+  vector<double> decoded(count);
+  double seconds = bench::measure([&] {
+    for (size_t i = 0; i < count; i++) {
+      decoded[i] = bit_converter::bytes_to_f64(raw.data() + i * 8, false);
+    }
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report("bytes_to_f64 decode", seconds, count, count * sizeof(double));
+}
@@ -0,0 +1,67 @@
+#include "bench.hpp"
+#include "bit_converter/hex.hpp"
+
+#include <cstdio>
+
+using std::vector;
+
+BENCHMARK(hex) {
+  const size_t size = 1 << 22;
+  vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; i++) {
+    bytes[i] = static_cast<uint8_t>(i * 0x9E3779B97F4A7C15ULL >> 56);
+  }
+  vector<char> hex(bit_converter::hex_size(size, '-'));
+  vector<uint8_t> decoded(size);
+
+  double seconds = bench::measure([&] {
+    char *output = hex.data();
+    for (size_t i = 0; i < size; i++) {
+      std::snprintf(output, 3, "%02X", bytes[i]);
+      output += 2;
+    }
+    bench::do_not_optimize(hex.data());
+  });
+  bench::report("snprintf %02X", seconds, size, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::detail::bytes_to_hex_scalar(bytes.data(), size, hex.data(),
+                                               '\0', true);
+    bench::do_not_optimize(hex.data());
+  });
+  bench::report("bytes_to_hex scalar", seconds, size, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::bytes_to_hex(bytes.data(), size, hex.data());
+    bench::do_not_optimize(hex.data());
+  });
+  bench::report("bytes_to_hex", seconds, size, size);
+
+  bool valid = true;
+  seconds = bench::measure([&] {
+    valid &= bit_converter::detail::hex_to_bytes_scalar(
+        hex.data(), size, decoded.data(), '\0');
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report("hex_to_bytes scalar", seconds, size, size);
+
+  seconds = bench::measure([&] {
+    valid &= bit_converter::hex_to_bytes(hex.data(), size * 2, decoded.data());
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report("hex_to_bytes", seconds, size, size);
+
+  seconds = bench::measure([&] {
+    bit_converter::bytes_to_hex(bytes.data(), size, hex.data(), '-');
+    bench::do_not_optimize(hex.data());
+  });
+  bench::report("bytes_to_hex with separator", seconds, size, size);
+
+  seconds = bench::measure([&] {
+    valid &= bit_converter::hex_to_bytes(hex.data(), hex.size(),
+                                         decoded.data(), '-');
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report("hex_to_bytes with separator", seconds, size, size);
+  bench::do_not_optimize(valid);
+}
@@ -0,0 +1,62 @@
+#include "bench.hpp"
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/parallel.hpp"
+
+using std::vector;
+
+BENCHMARK(bulk_u32) {
+  const size_t count = 1 << 24;
+  vector<uint32_t> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = static_cast<uint32_t>(i * 2654435761U);
+  }
+  vector<uint8_t> bytes(count * sizeof(uint32_t));
+  double seconds = bench::measure([&] {
+    for (size_t i = 0; i < count; i++) {
+      bit_converter::u32_to_bytes(values[i], true, bytes.data() + i * 4);
+    }
+    bench::do_not_optimize(bytes.data());
+  });
+  bench::report("u32_to_bytes per value", seconds, count, bytes.size());
+  seconds = bench::measure([&] {
+    bit_converter::values_to_bytes(values.data(), count, true, bytes.data());
+    bench::do_not_optimize(bytes.data());
+  });
+  bench::report("values_to_bytes", seconds, count, bytes.size());
+  vector<uint32_t> decoded(count);
+  seconds = bench::measure([&] {
+    bit_converter::bytes_to_values(static_cast<const uint8_t *>(bytes.data()),
+                                   count, true, decoded.data());
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report("bytes_to_values", seconds, count, bytes.size());
+}
+
+BENCHMARK(parallel_f64) {
+  const size_t count = size_t(1) << 25;
+  vector<double> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = static_cast<double>(i) * 0.5;
+  }
+  vector<uint8_t> bytes(count * sizeof(double));
+  vector<double> decoded(count);
+  const size_t max_threads = bit_converter::thread_pool::default_thread_count();
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    bit_converter::thread_pool pool(threads);
+    double seconds = bench::measure([&] {
+      bit_converter::values_to_bytes(values.data(), count, true, bytes.data(),
+                                     pool);
+      bench::do_not_optimize(bytes.data());
+    });
+    bench::report("values_to_bytes, " + std::to_string(threads) + " threads",
+                  seconds, count, bytes.size());
+    seconds = bench::measure([&] {
+      bit_converter::bytes_to_values(
+          static_cast<const uint8_t *>(bytes.data()), count, true,
+          decoded.data(), pool);
+      bench::do_not_optimize(decoded.data());
+    });
+    bench::report("bytes_to_values, " + std::to_string(threads) + " threads",
+                  seconds, count, bytes.size());
+  }
+}
@@ -0,0 +1,110 @@
+#include "bench.hpp"
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/pcm.hpp"
+
+using std::vector;
+
+using bit_converter::pcm_format;
+
+namespace {
+
+const size_t frames = 1 << 21;
+
+vector<uint8_t> make_pcm(size_t samples, size_t sample_size) {
+  vector<uint8_t> bytes(samples * sample_size);
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<uint8_t>(i * 131 + (i >> 9));
+  }
+  return bytes;
+}
+
+} // namespace
+
+BENCHMARK(pcm) {
+  const size_t samples = frames * 2;
+  vector<float> left(frames);
+  vector<float> right(frames);
+  float *planes[] = {left.data(), right.data()};
+  const float *const_planes[] = {left.data(), right.data()};
+
+  vector<uint8_t> s16 = make_pcm(samples, 2);
+  vector<int16_t> decoded(samples);
+  double seconds = bench::measure([&] {
+    for (size_t i = 0; i < samples; i++) {
+      decoded[i] = bit_converter::bytes_to_i16(s16.data() + i * 2, false);
+    }
+    for (size_t frame = 0; frame < frames; frame++) {
+      left[frame] = decoded[frame * 2] / 32768.0f;
+      right[frame] = decoded[frame * 2 + 1] / 32768.0f;
+    }
+    bench::do_not_optimize(left.data());
+    bench::do_not_optimize(right.data());
+  });
+  bench::report("s16 stereo bytes_to_i16 + divide", seconds, samples,
+                s16.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::pcm_to_float_planes(s16.data(), frames, 2, pcm_format::s16,
+                                       false, planes);
+    bench::do_not_optimize(left.data());
+  });
+  bench::report("s16 stereo pcm_to_float_planes", seconds, samples,
+                s16.size());
+
+  vector<uint8_t> s24 = make_pcm(samples, 3);
+  seconds = bench::measure([&] {
+    for (size_t frame = 0; frame < frames; frame++) {
+      for (size_t channel = 0; channel < 2; channel++) {
+        const uint8_t *sample = s24.data() + (frame * 2 + channel) * 3;
+        int32_t value = static_cast<int32_t>(uint32_t(sample[0]) << 8 |
+                                             uint32_t(sample[1]) << 16 |
+                                             uint32_t(sample[2]) << 24) >>
+                        8;
+        planes[channel][frame] = value / 8388608.0f;
+      }
+    }
+    bench::do_not_optimize(left.data());
+  });
+  bench::report("s24 stereo byte loop + divide", seconds, samples, s24.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::pcm_to_float_planes(s24.data(), frames, 2, pcm_format::s24,
+                                       false, planes);
+    bench::do_not_optimize(left.data());
+  });
+  bench::report("s24 stereo pcm_to_float_planes", seconds, samples,
+                s24.size());
+
+  vector<int16_t> scaled(samples);
+  seconds = bench::measure([&] {
+    for (size_t frame = 0; frame < frames; frame++) {
+      for (size_t channel = 0; channel < 2; channel++) {
+        float value = std::nearbyint(planes[channel][frame] * 32768.0f);
+        value = std::min(std::max(value, -32768.0f), 32767.0f);
+        scaled[frame * 2 + channel] = static_cast<int16_t>(value);
+      }
+    }
+    for (size_t i = 0; i < samples; i++) {
+      bit_converter::i16_to_bytes(scaled[i], false, s16.data() + i * 2);
+    }
+    bench::do_not_optimize(s16.data());
+  });
+  bench::report("s16 stereo round + i16_to_bytes", seconds, samples,
+                s16.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::float_planes_to_pcm(const_planes, frames, 2,
+                                       pcm_format::s16, false, s16.data());
+    bench::do_not_optimize(s16.data());
+  });
+  bench::report("s16 stereo float_planes_to_pcm", seconds, samples,
+                s16.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::float_planes_to_pcm(const_planes, frames, 2,
+                                       pcm_format::s24, false, s24.data());
+    bench::do_not_optimize(s24.data());
+  });
+  bench::report("s24 stereo float_planes_to_pcm", seconds, samples,
+                s24.size());
+}
@@ -0,0 +1,69 @@
+#include "bench.hpp"
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/quantize.hpp"
+
+#include <cmath>
+
+using std::vector;
+
+BENCHMARK(quantize) {
+  const size_t count = 1 << 22;
+  vector<float> weights(count);
+  for (size_t i = 0; i < count; i++) {
+    weights[i] = static_cast<float>(std::sin(i * 0.001) * 1.5);
+  }
+  const bit_converter::quantization<float> params{20000.0f, 0.0f};
+  vector<uint8_t> bytes(count * 2);
+
+  vector<float> scaled(count);
+  vector<int16_t> quantized(count);
+  double seconds = bench::measure([&] {
+    for (size_t i = 0; i < count; i++) {
+      scaled[i] = std::nearbyint(weights[i] * params.scale + params.offset);
+    }
+    for (size_t i = 0; i < count; i++) {
+      quantized[i] = static_cast<int16_t>(
+          std::min(std::max(scaled[i], -32768.0f), 32767.0f));
+    }
+    for (size_t i = 0; i < count; i++) {
+      bit_converter::i16_to_bytes(quantized[i], true, bytes.data() + i * 2);
+    }
+    bench::do_not_optimize(bytes.data());
+  });
+  bench::report("f32 -> i16 three loops", seconds, count, bytes.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::quantize_to_bytes<int16_t>(weights.data(), count, true,
+                                              params, bytes.data());
+    bench::do_not_optimize(bytes.data());
+  });
+  bench::report("f32 -> i16 quantize_to_bytes", seconds, count, bytes.size());
+
+  vector<uint8_t> small(count);
+  seconds = bench::measure([&] {
+    bit_converter::quantize_to_bytes<int8_t>(
+        weights.data(), count, true,
+        bit_converter::quantization<float>{80.0f, 0.0f}, small.data());
+    bench::do_not_optimize(small.data());
+  });
+  bench::report("f32 -> i8 quantize_to_bytes", seconds, count, small.size());
+
+  vector<float> restored(count);
+  seconds = bench::measure([&] {
+    for (size_t i = 0; i < count; i++) {
+      restored[i] = (bit_converter::bytes_to_i16(bytes.data() + i * 2, true) -
+                     params.offset) /
+                    params.scale;
+    }
+    bench::do_not_optimize(restored.data());
+  });
+  bench::report("i16 -> f32 bytes_to_i16 + divide", seconds, count,
+                bytes.size());
+
+  seconds = bench::measure([&] {
+    bit_converter::dequantize_bytes<int16_t>(bytes.data(), count, true, params,
+                                             restored.data());
+    bench::do_not_optimize(restored.data());
+  });
+  bench::report("i16 -> f32 dequantize_bytes", seconds, count, bytes.size());
+}
@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/radix_sort.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+using std::vector;
+
+namespace {
+
+const size_t count = 1 << 22;
+
+/**
+ * @brief Decode the keys, sort the values with `std::sort` and sort the
+ * encoded records with `radix_sort_records`. Each record is a key written
+ * by `value_to_key` and a 4-byte row number.
+ */
+template <typename T>
+void bench_sort(const char *name, const vector<T> &values) {
+  const size_t record_size = sizeof(T) + 4;
+  vector<uint8_t> records;
+  for (size_t i = 0; i < count; i++) {
+    bit_converter::value_to_key(values[i], std::back_inserter(records));
+    uint32_t row = static_cast<uint32_t>(i);
+    bit_converter::values_to_bytes(&row, 1, true,
+                                   std::back_inserter(records));
+  }
+
+  vector<std::pair<T, uint32_t>> decoded(count);
+  double seconds = bench::measure([&] {
+    for (size_t i = 0; i < count; i++) {
+      const uint8_t *record = records.data() + i * record_size;
+      decoded[i] = {bit_converter::key_to_value<T>(record),
+                    bit_converter::bytes_to_u32(record + sizeof(T), true)};
+    }
+    std::sort(decoded.begin(), decoded.end());
+    bench::do_not_optimize(decoded.data());
+  });
+  bench::report(std::string(name) + " decode + std::sort", seconds, count,
+                records.size());
+
+  vector<uint8_t> work(records.size());
+  vector<uint8_t> scratch(records.size());
+  seconds = bench::measure([&] {
+    work = records;
+    bit_converter::radix_sort_records(work.data(), count, record_size,
+                                      sizeof(T), scratch.data());
+    bench::do_not_optimize(work.data());
+  });
+  bench::report(std::string(name) + " radix_sort_records", seconds, count,
+                records.size());
+}
+
+} // namespace
+
+BENCHMARK(radix_sort) {
+  uint64_t state = 88172645463325252ULL;
+  auto next = [&] {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  };
+  vector<int64_t> i64(count);
+  vector<int64_t> small(count);
+  vector<int32_t> i32(count);
+  vector<double> f64(count);
+  for (size_t i = 0; i < count; i++) {
+    i64[i] = static_cast<int64_t>(next());
+    small[i] = static_cast<int64_t>(next() % 1000000) - 500000;
+    i32[i] = static_cast<int32_t>(next());
+    f64[i] = static_cast<double>(static_cast<int64_t>(next())) * 1e-9;
+  }
+  bench_sort("i64", i64);
+  bench_sort("i64 in +-500000", small);
+  bench_sort("i32", i32);
+  bench_sort("f64", f64);
+}
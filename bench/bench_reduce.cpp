@@ -0,0 +1,45 @@
+#include "bench.hpp"
+#include "bit_converter/reduce.hpp"
+
+using std::vector;
+
+namespace {
+
+template <typename T> void bench_reduce(const char *name) {
+  const size_t count = 1 << 23;
+  vector<T> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = static_cast<T>(static_cast<int64_t>(i * 2654435761U) - 1000);
+  }
+  vector<uint8_t> bytes(count * sizeof(T));
+  bit_converter::values_to_bytes(values.data(), count, true, bytes.data());
+
+  vector<T> decoded(count);
+  double seconds = bench::measure([&] {
+    bit_converter::bytes_to_values(static_cast<const uint8_t *>(bytes.data()),
+                                   count, true, decoded.data());
+    bit_converter::reduction<T> result;
+    for (T value : decoded) {
+      result.sum += value;
+      result.min = std::min(result.min, value);
+      result.max = std::max(result.max, value);
+    }
+    bench::do_not_optimize(result);
+  });
+  bench::report(std::string(name) + " bytes_to_values + loop", seconds, count,
+                bytes.size());
+
+  seconds = bench::measure([&] {
+    auto result = bit_converter::reduce_bytes<T>(bytes.data(), count, true);
+    bench::do_not_optimize(result);
+  });
+  bench::report(std::string(name) + " reduce_bytes", seconds, count,
+                bytes.size());
+}
+
+} // namespace
+
+BENCHMARK(reduce) {
+  bench_reduce<int64_t>("i64");
+  bench_reduce<double>("f64");
+}
@@ -0,0 +1,81 @@
+#include "bench.hpp"
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/staging_queue.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using std::vector;
+
+namespace {
+
+const size_t producer_count = 4;
+const size_t event_count = 1 << 18;
+
+template <typename Produce, typename Flush>
+void run_producers(Produce produce, Flush flush) {
+  std::atomic<size_t> running{producer_count};
+  vector<std::thread> producers;
+  for (size_t p = 0; p < producer_count; p++) {
+    producers.emplace_back([&] {
+      for (size_t i = 0; i < event_count; i++) {
+        produce(i);
+      }
+      running--;
+    });
+  }
+  while (running > 0) {
+    flush();
+    std::this_thread::yield();
+  }
+  flush();
+  for (auto &producer : producers) {
+    producer.join();
+  }
+}
+
+} // namespace
+
+BENCHMARK(staging_queue) {
+  const size_t total = producer_count * event_count;
+
+  double seconds = bench::measure([&] {
+    std::mutex mutex;
+    vector<uint8_t> log;
+    vector<uint8_t> flushed;
+    run_producers(
+        [&](size_t i) {
+          std::lock_guard<std::mutex> lock(mutex);
+          auto output = std::back_inserter(log);
+          output = bit_converter::i64_to_bytes(static_cast<int64_t>(i), true,
+                                               output);
+          bit_converter::f64_to_bytes(static_cast<double>(i), true, output);
+        },
+        [&] {
+          std::lock_guard<std::mutex> lock(mutex);
+          flushed.swap(log);
+          log.clear();
+          bench::do_not_optimize(flushed.data());
+        });
+  });
+  bench::report("mutex-guarded vector", seconds, total, total * 16);
+
+  seconds = bench::measure([&] {
+    bit_converter::mpsc_staging_queue queue(1 << 20);
+    run_producers(
+        [&](size_t i) {
+          queue.encode(16, [&](uint8_t *output) {
+            output = bit_converter::i64_to_bytes(static_cast<int64_t>(i), true,
+                                                 output);
+            bit_converter::f64_to_bytes(static_cast<double>(i), true, output);
+          });
+        },
+        [&] {
+          queue.drain([](const uint8_t *data, size_t) {
+            bench::do_not_optimize(data);
+          });
+        });
+  });
+  bench::report("mpsc_staging_queue", seconds, total, total * 16);
+}
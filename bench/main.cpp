@@ -0,0 +1,21 @@
+#include "bench.hpp"
+
+#include <cstring>
+
+int main(int argc, char **argv) {
+  const char *filter = "";
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--perf") == 0) {
+      bench::enable_perf_counters();
+    } else {
+      filter = argv[i];
+    }
+  }
+  for (const auto &benchmark : bench::registry()) {
+    if (std::strstr(benchmark.name, filter) != nullptr) {
+      std::printf("== %s\n", benchmark.name);
+      benchmark.run();
+    }
+  }
+  return 0;
+}
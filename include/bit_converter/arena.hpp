@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace bit_converter {
+
+using std::size_t;
+
+/**
+ * @brief Hands out byte blocks by bumping a pointer through large slabs. The
+ * blocks are never freed one by one; `reset` recycles all of them at once
+ * and keeps the slabs for the next batch.
+ */
+class byte_arena {
+public:
+  static constexpr size_t default_slab_size = 1 << 20;
+
+  explicit byte_arena(size_t slab_size = default_slab_size)
+      : slab_size(slab_size) {}
+
+  byte_arena(const byte_arena &) = delete;
+  byte_arena &operator=(const byte_arena &) = delete;
+
+  /**
+   * @brief Returns a block of `size` bytes that stays valid until `reset`.
+   */
+  uint8_t *allocate(size_t size) {
+    if (slabs.empty() || used + size > slabs[current].size) {
+      next_slab(size);
+    }
+    uint8_t *block = slabs[current].data.get() + used;
+    used += size;
+    return block;
+  }
+
+  /**
+   * @brief Grow the most recent block in place. Returns false, leaving the
+   * block unchanged, when it is not the most recent one or the slab is full.
+   */
+  bool extend(const uint8_t *block, size_t old_size, size_t new_size) {
+    if (slabs.empty() || block + old_size != slabs[current].data.get() + used ||
+        used - old_size + new_size > slabs[current].size) {
+      return false;
+    }
+    used = used - old_size + new_size;
+    return true;
+  }
+
+  /**
+   * @brief Invalidate every block handed out so far and start again from the
+   * first slab.
+   */
+  void reset() {
+    current = 0;
+    used = 0;
+  }
+
+  /**
+   * @brief The total size of the slabs owned by the arena.
+   */
+  size_t capacity() const {
+    size_t total = 0;
+    for (const auto &slab : slabs) {
+      total += slab.size;
+    }
+    return total;
+  }
+
+private:
+  struct slab {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size;
+  };
+
+  void next_slab(size_t size) {
+    size_t next = slabs.empty() ? 0 : current + 1;
+    // Reuse a slab kept by `reset` when one is large enough.
+    auto found = std::find_if(
+        slabs.begin() + static_cast<std::ptrdiff_t>(next), slabs.end(),
+        [&](const slab &candidate) { return candidate.size >= size; });
+    if (found == slabs.end()) {
+      size_t new_size = std::max(slab_size, size);
+      slabs.push_back(
+          {std::unique_ptr<uint8_t[]>(new uint8_t[new_size]), new_size});
+      found = slabs.end() - 1;
+    }
+    std::swap(slabs[next], *found);
+    current = next;
+    used = 0;
+  }
+
+  size_t slab_size;
+  std::vector<slab> slabs;
+  size_t current = 0;
+  size_t used = 0;
+};
+
+/**
+ * @brief A growable byte buffer whose storage comes from a `byte_arena`. It
+ * works with `std::back_inserter`, so every `*_to_bytes` function can write to
+ * it, and `grow` returns a plain pointer for bulk conversions.
+ *
+ * The contents are invalidated when the arena is reset.
+ */
+class arena_buffer {
+public:
+  using value_type = uint8_t;
+  using iterator = uint8_t *;
+  using const_iterator = const uint8_t *;
+
+  explicit arena_buffer(byte_arena &arena, size_t capacity = 64)
+      : arena(&arena), storage(arena.allocate(capacity)),
+        storage_size(capacity) {}
+
+  // Copies would share the storage, so a buffer can only be moved. The
+  // moved-from buffer is left empty and allocates afresh when it grows.
+  arena_buffer(const arena_buffer &) = delete;
+  arena_buffer &operator=(const arena_buffer &) = delete;
+
+  arena_buffer(arena_buffer &&other) noexcept
+      : arena(other.arena), storage(std::exchange(other.storage, nullptr)),
+        storage_size(std::exchange(other.storage_size, 0)),
+        length(std::exchange(other.length, 0)) {}
+
+  arena_buffer &operator=(arena_buffer &&other) noexcept {
+    arena = other.arena;
+    storage = std::exchange(other.storage, nullptr);
+    storage_size = std::exchange(other.storage_size, 0);
+    length = std::exchange(other.length, 0);
+    return *this;
+  }
+
+  void push_back(uint8_t b) { *grow(1) = b; }
+
+  /**
+   * @brief Append `size` uninitialized bytes and return a pointer to them.
+   */
+  uint8_t *grow(size_t size) {
+    if (length + size > storage_size) {
+      reserve(std::max(storage_size * 2, length + size));
+    }
+    uint8_t *end = storage + length;
+    length += size;
+    return end;
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity <= storage_size) {
+      return;
+    }
+    if (!arena->extend(storage, storage_size, capacity)) {
+      uint8_t *moved = arena->allocate(capacity);
+      if (length > 0) {
+        std::memcpy(moved, storage, length);
+      }
+      storage = moved;
+    }
+    storage_size = capacity;
+  }
+
+  /**
+   * @brief Give the unused capacity back to the arena when this buffer holds
+   * its most recent block, so that the next message starts right after it.
+   */
+  void shrink_to_fit() {
+    if (arena->extend(storage, storage_size, length)) {
+      storage_size = length;
+    }
+  }
+
+  void clear() { length = 0; }
+
+  uint8_t *data() { return storage; }
+  const uint8_t *data() const { return storage; }
+  size_t size() const { return length; }
+  uint8_t *begin() { return storage; }
+  uint8_t *end() { return storage + length; }
+  const uint8_t *begin() const { return storage; }
+  const uint8_t *end() const { return storage + length; }
+
+private:
+  byte_arena *arena;
+  uint8_t *storage;
+  size_t storage_size;
+  size_t length = 0;
+};
+
+}; // namespace bit_converter
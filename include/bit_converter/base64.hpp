@@ -0,0 +1,432 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "bulk.hpp"
+#include "detail.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace bit_converter {
+
+namespace detail {
+
+/**
+ * @brief The alphabet of a Base64 variant, the two characters of every
+ * 12-bit value, the value of every character, with 0xFF for those outside
+ * the alphabet, and the nibble tables of the AVX2 decoder.
+ *
+ * A character is valid when `lower[c & 0xF] & upper[c >> 4]` is zero:
+ * `upper` gives each high nibble that can start a valid character its own
+ * bit, and `lower` sets the bits of the high nibbles that have no valid
+ * character with that low nibble. `offset[c >> 4]` added to a character
+ * gives its value, except for the 64th character, which is the only one
+ * whose offset differs from the rest of its high nibble.
+ */
+struct base64_tables {
+  char digits[64];
+  char pairs[4096][2];
+  uint8_t values[256];
+  uint8_t lower[16];
+  uint8_t upper[16];
+  int8_t offset[16];
+
+  constexpr explicit base64_tables(const char *alphabet)
+      : digits(), pairs(), values(), lower(), upper(), offset() {
+    for (int i = 0; i < 256; i++) {
+      values[i] = 0xFF;
+    }
+    for (int i = 0; i < 64; i++) {
+      digits[i] = alphabet[i];
+      values[static_cast<uint8_t>(alphabet[i])] = static_cast<uint8_t>(i);
+    }
+    for (int i = 0; i < 4096; i++) {
+      pairs[i][0] = alphabet[i >> 6];
+      pairs[i][1] = alphabet[i & 0x3F];
+    }
+    for (int high = 0; high < 16; high++) {
+      bool is_used = high >= 2 && high <= 7;
+      upper[high] = static_cast<uint8_t>(is_used ? 1 << (high - 2) : 0x80);
+      for (int low = 0; low < 16; low++) {
+        if (is_used && values[high << 4 | low] == 0xFF) {
+          lower[low] = static_cast<uint8_t>(lower[low] | upper[high]);
+        }
+      }
+    }
+    for (int low = 0; low < 16; low++) {
+      lower[low] = static_cast<uint8_t>(lower[low] | 0x80);
+    }
+    for (int i = 0; i < 63; i++) {
+      uint8_t c = static_cast<uint8_t>(alphabet[i]);
+      offset[c >> 4] = static_cast<int8_t>(i - c);
+    }
+  }
+};
+
+inline const base64_tables &base64_lookup(bool is_url_safe) {
+  static constexpr base64_tables standard(
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+  static constexpr base64_tables url(
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+  return is_url_safe ? url : standard;
+}
+
+/**
+ * @brief Encode six bytes into eight characters at a time from one 64-bit
+ * load, two characters per table lookup, then the remaining whole groups of
+ * three bytes. Returns the number of bytes encoded, a multiple of three.
+ */
+inline size_t bytes_to_base64_scalar(const uint8_t *data, size_t size,
+                                     char *output,
+                                     const base64_tables &tables) {
+  const auto &pairs = tables.pairs;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 6, output += 8) {
+    uint64_t bits = load_unaligned<uint64_t>(data + i);
+    if (is_little_endian_host) {
+      bits = byte_swap(bits);
+    }
+    for (int k = 0; k < 4; k++) {
+      const char *pair = pairs[(bits >> (52 - 12 * k)) & 0xFFF];
+      output[2 * k] = pair[0];
+      output[2 * k + 1] = pair[1];
+    }
+  }
+  for (; i + 3 <= size; i += 3, output += 4) {
+    uint32_t bits = static_cast<uint32_t>(data[i]) << 16 |
+                    static_cast<uint32_t>(data[i + 1]) << 8 | data[i + 2];
+    output[0] = pairs[bits >> 12][0];
+    output[1] = pairs[bits >> 12][1];
+    output[2] = pairs[bits & 0xFFF][0];
+    output[3] = pairs[bits & 0xFFF][1];
+  }
+  return i;
+}
+
+/**
+ * @brief Decode `count` groups of four characters into three bytes each.
+ * An invalid character has the value 0xFF, so the bits above the lowest six
+ * of the combined values show whether any was invalid.
+ */
+inline bool base64_to_bytes_scalar(const char *input, size_t count,
+                                   uint8_t *output, const uint8_t *values) {
+  for (size_t i = 0; i < count; i++, input += 4, output += 3) {
+    uint32_t a = values[static_cast<uint8_t>(input[0])];
+    uint32_t b = values[static_cast<uint8_t>(input[1])];
+    uint32_t c = values[static_cast<uint8_t>(input[2])];
+    uint32_t d = values[static_cast<uint8_t>(input[3])];
+    if ((a | b | c | d) & 0xC0) {
+      return false;
+    }
+    uint32_t bits = a << 18 | b << 12 | c << 6 | d;
+    output[0] = static_cast<uint8_t>(bits >> 16);
+    output[1] = static_cast<uint8_t>(bits >> 8);
+    output[2] = static_cast<uint8_t>(bits);
+  }
+  return true;
+}
+
+#if defined(__AVX2__)
+
+/**
+ * @brief Encode 24 bytes into 32 characters at a time. Each lane takes
+ * twelve bytes, spreads every group of three over four bytes with `pshufb`,
+ * and moves the four sextets of each group into place with two multiplies.
+ * The sextets become characters by adding the offset of their range, which
+ * a `pshufb` looks up from a small range number.
+ */
+inline size_t bytes_to_base64_simd(const uint8_t *data, size_t size,
+                                   char *output, const char *digits) {
+  const __m256i spread = _mm256_setr_epi8(
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5,
+      4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const int8_t upper_offset = static_cast<int8_t>('a' - 26);
+  const int8_t digit_offset = static_cast<int8_t>('0' - 52);
+  const int8_t offset_62 = static_cast<int8_t>(digits[62] - 62);
+  const int8_t offset_63 = static_cast<int8_t>(digits[63] - 63);
+  const __m256i offsets = _mm256_setr_epi8(
+      upper_offset, digit_offset, digit_offset, digit_offset, digit_offset,
+      digit_offset, digit_offset, digit_offset, digit_offset, digit_offset,
+      digit_offset, offset_62, offset_63, 'A', 0, 0, upper_offset,
+      digit_offset, digit_offset, digit_offset, digit_offset, digit_offset,
+      digit_offset, digit_offset, digit_offset, digit_offset, digit_offset,
+      offset_62, offset_63, 'A', 0, 0);
+  size_t i = 0;
+  // The second lane loads 16 bytes to use 12 of them.
+  for (; i + 28 <= size; i += 24, output += 32) {
+    __m256i bytes = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 12)), 1);
+    bytes = _mm256_shuffle_epi8(bytes, spread);
+    __m256i first = _mm256_mulhi_epu16(
+        _mm256_and_si256(bytes, _mm256_set1_epi32(0x0FC0FC00)),
+        _mm256_set1_epi32(0x04000040));
+    __m256i second = _mm256_mullo_epi16(
+        _mm256_and_si256(bytes, _mm256_set1_epi32(0x003F03F0)),
+        _mm256_set1_epi32(0x01000010));
+    __m256i sextets = _mm256_or_si256(first, second);
+    // 0 for 'a'-'z', 1-10 for '0'-'9', 11 and 12 for the last two
+    // characters, and 13 for 'A'-'Z'.
+    __m256i ranges = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+    ranges = _mm256_or_si256(
+        ranges,
+        _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets),
+                         _mm256_set1_epi8(13)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(output),
+        _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, ranges)));
+  }
+  return i;
+}
+
+/**
+ * @brief Decode 32 characters into 24 bytes at a time. Characters are
+ * validated and given their values with nibble lookups from
+ * `base64_tables`, and the sextets are joined with two multiply-adds.
+ * Returns the number of characters decoded, or `size` plus one when a
+ * block holds an invalid character.
+ */
+inline size_t base64_to_bytes_simd(const char *input, size_t size,
+                                   uint8_t *output,
+                                   const base64_tables &tables) {
+  const __m256i lower = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(tables.lower)));
+  const __m256i upper = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(tables.upper)));
+  const __m256i offsets = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(tables.offset)));
+  const __m256i last = _mm256_set1_epi8(tables.digits[63]);
+  const __m256i last_offset =
+      _mm256_set1_epi8(static_cast<char>(63 - tables.digits[63]));
+  const __m256i mask = _mm256_set1_epi8(0x0F);
+  const __m256i gather = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+      4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32, output += 24) {
+    __m256i chars =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i));
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(chars, 4), mask);
+    __m256i low = _mm256_and_si256(chars, mask);
+    if (!_mm256_testz_si256(_mm256_shuffle_epi8(lower, low),
+                            _mm256_shuffle_epi8(upper, high))) {
+      return size + 1;
+    }
+    __m256i offset = _mm256_blendv_epi8(_mm256_shuffle_epi8(offsets, high),
+                                        last_offset,
+                                        _mm256_cmpeq_epi8(chars, last));
+    __m256i sextets = _mm256_add_epi8(chars, offset);
+    // Join pairs of sextets into 12 bits, then pairs of those into 24.
+    __m256i pairs =
+        _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+    __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    groups = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(groups, gather), compact);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output),
+                     _mm256_castsi256_si128(groups));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(output + 16),
+                     _mm256_extracti128_si256(groups, 1));
+  }
+  return i;
+}
+
+#endif
+
+/**
+ * @brief The number of characters before any padding, which is the length
+ * of the encoded data.
+ */
+inline size_t base64_unpadded_size(const char *input, size_t size) {
+  if (size % 4 != 0 || size == 0 || input[size - 1] != '=') {
+    return size;
+  }
+  return input[size - 2] == '=' ? size - 2 : size - 1;
+}
+
+}; // namespace detail
+
+/**
+ * @brief Returns the number of characters `bytes_to_base64` writes for
+ * `size` bytes: four per group of three, with the last group padded with
+ * '=' to four characters unless `is_padded` is false.
+ */
+inline size_t base64_size(size_t size, bool is_padded = true) {
+  if (is_padded) {
+    return (size + 2) / 3 * 4;
+  }
+  return size / 3 * 4 + (size % 3 != 0 ? size % 3 + 1 : 0);
+}
+
+/**
+ * @brief Returns the number of bytes `base64_to_bytes` writes for the
+ * `size` characters at `input`, rounded down when `size` is not a valid
+ * length.
+ */
+inline size_t base64_decoded_size(const char *input, size_t size) {
+  size_t unpadded = detail::base64_unpadded_size(input, size);
+  return unpadded / 4 * 3 + (unpadded % 4 > 1 ? unpadded % 4 - 1 : 0);
+}
+
+/**
+ * @brief Write the bytes as Base64 with the standard alphabet, or the
+ * URL-safe one of RFC 4648, which has '-' and '_' in place of '+' and '/',
+ * when `is_url_safe` is true. Returns the position after the last
+ * character; no terminating null is written. The output needs room for
+ * `base64_size(size, is_padded)` characters.
+ */
+inline char *bytes_to_base64(const uint8_t *data, size_t size, char *output,
+                             bool is_url_safe = false, bool is_padded = true) {
+  const detail::base64_tables &tables = detail::base64_lookup(is_url_safe);
+  const char *digits = tables.digits;
+  size_t done = 0;
+#if defined(__AVX2__)
+  done = detail::bytes_to_base64_simd(data, size, output, digits);
+  output += done / 3 * 4;
+#endif
+  size_t rest =
+      detail::bytes_to_base64_scalar(data + done, size - done, output, tables);
+  output += rest / 3 * 4;
+  done += rest;
+  if (done == size) {
+    return output;
+  }
+  uint32_t bits = static_cast<uint32_t>(data[done]) << 16;
+  if (size - done == 2) {
+    bits |= static_cast<uint32_t>(data[done + 1]) << 8;
+  }
+  *output++ = digits[bits >> 18];
+  *output++ = digits[(bits >> 12) & 0x3F];
+  if (size - done == 2) {
+    *output++ = digits[(bits >> 6) & 0x3F];
+  } else if (is_padded) {
+    *output++ = '=';
+  }
+  if (is_padded) {
+    *output++ = '=';
+  }
+  return output;
+}
+
+/**
+ * @brief Returns the bytes as a Base64 string.
+ */
+inline std::string to_base64_string(const uint8_t *data, size_t size,
+                                    bool is_url_safe = false,
+                                    bool is_padded = true) {
+  std::string text(base64_size(size, is_padded), '\0');
+  bytes_to_base64(data, size, &text[0], is_url_safe, is_padded);
+  return text;
+}
+
+/**
+ * @brief Decode `size` characters of Base64, with or without padding, into
+ * `base64_decoded_size(input, size)` bytes. Returns false when the length
+ * is not one `bytes_to_base64` produces, a character is outside the
+ * alphabet, or the bits after the last byte are not zero; the output is
+ * then left partly written.
+ */
+inline bool base64_to_bytes(const char *input, size_t size, uint8_t *output,
+                            bool is_url_safe = false) {
+  const detail::base64_tables &tables = detail::base64_lookup(is_url_safe);
+  const size_t unpadded = detail::base64_unpadded_size(input, size);
+  if (unpadded % 4 == 1) {
+    return false;
+  }
+  size_t done = 0;
+#if defined(__AVX2__)
+  done = detail::base64_to_bytes_simd(input, unpadded, output, tables);
+  if (done > unpadded) {
+    return false;
+  }
+  output += done / 4 * 3;
+#endif
+  const size_t groups = (unpadded - done) / 4;
+  if (!detail::base64_to_bytes_scalar(input + done, groups, output,
+                                      tables.values)) {
+    return false;
+  }
+  input += done + groups * 4;
+  output += groups * 3;
+  const size_t rest = unpadded % 4;
+  if (rest == 0) {
+    return true;
+  }
+  uint32_t a = tables.values[static_cast<uint8_t>(input[0])];
+  uint32_t b = tables.values[static_cast<uint8_t>(input[1])];
+  uint32_t c = rest == 3 ? tables.values[static_cast<uint8_t>(input[2])] : 0;
+  uint32_t bits = a << 18 | b << 12 | c << 6;
+  uint32_t unused = rest == 3 ? bits & 0xFF : bits & 0xFFFF;
+  if ((a | b | c) & 0xC0 || unused != 0) {
+    return false;
+  }
+  output[0] = static_cast<uint8_t>(bits >> 16);
+  if (rest == 3) {
+    output[1] = static_cast<uint8_t>(bits >> 8);
+  }
+  return true;
+}
+
+/**
+ * @brief Encode an array of integers or floating-point numbers as
+ * `values_to_bytes` would and write the bytes as Base64, without a buffer
+ * for the whole array. Values already in the requested order are encoded
+ * straight from their memory; the others are converted a chunk at a time
+ * into a buffer that stays in the L1 cache. Returns the position after the
+ * last character.
+ */
+template <typename T>
+inline char *values_to_base64(const T *values, size_t count,
+                              bool is_big_endian, char *output,
+                              bool is_url_safe = false,
+                              bool is_padded = true) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "values_to_base64 needs an integer or floating-point type");
+  if (!detail::needs_byte_swap(is_big_endian)) {
+    return bytes_to_base64(reinterpret_cast<const uint8_t *>(values),
+                           count * sizeof(T), output, is_url_safe, is_padded);
+  }
+  // A multiple of three bytes, so no chunk but the last needs padding.
+  constexpr size_t chunk_bytes = detail::bulk_chunk_bytes / 4 * 3;
+  constexpr size_t chunk = chunk_bytes / sizeof(T);
+  uint8_t buffer[chunk_bytes];
+  for (size_t offset = 0; offset < count; offset += chunk) {
+    size_t n = std::min(count - offset, chunk);
+    detail::encode_values(values + offset, n, is_big_endian, buffer);
+    output = bytes_to_base64(buffer, n * sizeof(T), output, is_url_safe,
+                             is_padded);
+  }
+  return output;
+}
+
+/**
+ * @brief Decode Base64 holding exactly `count` values written by
+ * `values_to_base64`. The bytes are decoded straight into `values` and
+ * swapped in place when needed. Returns false, as `base64_to_bytes` does,
+ * for malformed input or when the length does not match `count`.
+ */
+template <typename T>
+inline bool base64_to_values(const char *input, size_t size, T *values,
+                             size_t count, bool is_big_endian,
+                             bool is_url_safe = false) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "base64_to_values needs an integer or floating-point type");
+  if (base64_decoded_size(input, size) != count * sizeof(T)) {
+    return false;
+  }
+  uint8_t *bytes = reinterpret_cast<uint8_t *>(values);
+  if (!base64_to_bytes(input, size, bytes, is_url_safe)) {
+    return false;
+  }
+  if (detail::needs_byte_swap(is_big_endian)) {
+    detail::decode_values(bytes, count, is_big_endian, values);
+  }
+  return true;
+}
+
+}; // namespace bit_converter
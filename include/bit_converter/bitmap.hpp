@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "detail.hpp"
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace bit_converter {
+
+using std::size_t;
+using std::vector;
+
+namespace detail {
+
+constexpr size_t bitmap_chunk_bytes = 512;
+
+/**
+ * @brief Pack eight booleans (one per byte lane of a little-endian word) into
+ * a single byte.
+ */
+inline uint8_t pack_bool_lanes(uint64_t lanes, bool is_msb_first) {
+#if defined(__BMI2__)
+  uint64_t packed = _pext_u64(lanes, 0x0101010101010101ULL);
+  return static_cast<uint8_t>(is_msb_first ? reverse_bits_in_bytes(packed)
+                                           : packed);
+#else
+  return static_cast<uint8_t>(
+      (lanes * (is_msb_first ? 0x8040201008040201ULL : 0x0102040810204080ULL)) >>
+      56);
+#endif
+}
+
+/**
+ * @brief Expand a byte into eight booleans, one per byte lane of a
+ * little-endian word.
+ */
+inline uint64_t unpack_bool_lanes(uint8_t b, bool is_msb_first) {
+#if defined(__BMI2__)
+  uint64_t lanes = _pdep_u64(b, 0x0101010101010101ULL);
+  return is_msb_first ? byte_swap(lanes) : lanes;
+#else
+  uint64_t lanes = (b * 0x0101010101010101ULL) &
+                   (is_msb_first ? 0x0102040810204080ULL
+                                 : 0x8040201008040201ULL);
+  return ((lanes + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+#endif
+}
+
+/**
+ * @brief Pack `bit_count` booleans into `(bit_count + 7) / 8` bytes. The
+ * unused bits of a partial final byte are zero.
+ */
+inline void pack_bools(const bool *bits, size_t bit_count, bool is_msb_first,
+                       uint8_t *output) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 32 <= bit_count; i += 32) {
+    __m256i lanes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + i));
+    uint64_t mask = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_slli_epi16(lanes, 7)));
+    if (is_msb_first) {
+      mask = reverse_bits_in_bytes(mask);
+    }
+    for (int k = 0; k < 4; k++) {
+      output[i / 8 + k] = static_cast<uint8_t>(mask >> (8 * k));
+    }
+  }
+#elif defined(__SSE2__)
+  for (; i + 16 <= bit_count; i += 16) {
+    __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bits + i));
+    uint64_t mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_slli_epi16(lanes, 7)));
+    if (is_msb_first) {
+      mask = reverse_bits_in_bytes(mask);
+    }
+    output[i / 8] = static_cast<uint8_t>(mask);
+    output[i / 8 + 1] = static_cast<uint8_t>(mask >> 8);
+  }
+#endif
+  for (; i + 8 <= bit_count; i += 8) {
+    uint8_t lanes[8];
+    std::memcpy(lanes, bits + i, 8);
+    output[i / 8] = pack_bool_lanes(load_u64_le(lanes), is_msb_first);
+  }
+  if (i < bit_count) {
+    uint8_t lanes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    std::memcpy(lanes, bits + i, bit_count - i);
+    output[i / 8] = pack_bool_lanes(load_u64_le(lanes), is_msb_first);
+  }
+}
+
+/**
+ * @brief Expand `(bit_count + 7) / 8` bytes into `bit_count` booleans.
+ */
+inline void unpack_bools(const uint8_t *input, size_t bit_count,
+                         bool is_msb_first, bool *bits) {
+  size_t i = 0;
+  for (; i + 8 <= bit_count; i += 8) {
+    uint8_t lanes[8];
+    store_u64_le(lanes, unpack_bool_lanes(input[i / 8], is_msb_first));
+    std::memcpy(bits + i, lanes, 8);
+  }
+  if (i < bit_count) {
+    uint8_t lanes[8];
+    store_u64_le(lanes, unpack_bool_lanes(input[i / 8], is_msb_first));
+    std::memcpy(bits + i, lanes, bit_count - i);
+  }
+}
+
+/**
+ * @brief Write the low `byte_count` bytes of a bitmap word whose bit `j` holds
+ * bitmap position `j`.
+ */
+template <typename OutputIt>
+inline OutputIt store_bitmap_word(uint64_t word, size_t byte_count,
+                                  bool is_msb_first, OutputIt output_it) {
+  if (is_msb_first) {
+    word = reverse_bits_in_bytes(word);
+  }
+  for (size_t k = 0; k < byte_count; k++) {
+    *output_it = static_cast<uint8_t>(word >> (8 * k));
+    output_it++;
+  }
+  return output_it;
+}
+
+/**
+ * @brief Read `byte_count` bytes into a bitmap word whose bit `j` holds bitmap
+ * position `j`.
+ */
+template <typename InputIt>
+inline uint64_t load_bitmap_word(InputIt &input_it, size_t byte_count,
+                                 bool is_msb_first) {
+  uint64_t word = 0;
+  for (size_t k = 0; k < byte_count; k++) {
+    word |= static_cast<uint64_t>(static_cast<uint8_t>(*input_it)) << (8 * k);
+    input_it++;
+  }
+  return is_msb_first ? reverse_bits_in_bytes(word) : word;
+}
+
+inline uint64_t low_bits_mask(size_t bit_count) {
+  return bit_count >= 64 ? ~0ULL : ((1ULL << bit_count) - 1);
+}
+
+/**
+ * @brief Returns the storage words of a `std::vector<bool>`, where bit `j` of
+ * word `k` holds position `64 * k + j`, or null when that layout is unknown.
+ *
+ * This is the only code that depends on a private standard library layout:
+ * libstdc++ keeps the bits in an array of `std::_Bit_type` words reached
+ * through the iterator's `_M_p`, and the "test vector<bool> word layout" test
+ * pins it. Elsewhere the callers fall back to one proxy bit at a time.
+ */
+inline const uint64_t *vector_bool_words(const vector<bool> &bits) {
+#if defined(__GLIBCXX__)
+  if constexpr (sizeof(std::_Bit_type) == sizeof(uint64_t)) {
+    return reinterpret_cast<const uint64_t *>(bits.begin()._M_p);
+  }
+#endif
+  (void)bits;
+  return nullptr;
+}
+
+inline uint64_t *vector_bool_words(vector<bool> &bits) {
+  return const_cast<uint64_t *>(
+      vector_bool_words(static_cast<const vector<bool> &>(bits)));
+}
+
+/**
+ * @brief Returns the 64 bitmap positions starting at `offset`, a multiple of
+ * 64, as one word.
+ */
+inline uint64_t bit_vector_word(const vector<bool> &bits, size_t offset) {
+  size_t count = std::min<size_t>(bits.size() - offset, 64);
+  if (const uint64_t *words = vector_bool_words(bits)) {
+    return words[offset / 64] & low_bits_mask(count);
+  }
+  uint64_t word = 0;
+  auto it = bits.begin() + static_cast<std::ptrdiff_t>(offset);
+  for (size_t j = 0; j < count; j++, ++it) {
+    word |= static_cast<uint64_t>(*it) << j;
+  }
+  return word;
+}
+
+/**
+ * @brief Store one word into the 64 bitmap positions starting at `offset`, a
+ * multiple of 64.
+ */
+inline void set_bit_vector_word(vector<bool> &bits, size_t offset,
+                                uint64_t word) {
+  size_t count = std::min<size_t>(bits.size() - offset, 64);
+  if (uint64_t *words = vector_bool_words(bits)) {
+    words[offset / 64] = word & low_bits_mask(count);
+    return;
+  }
+  auto it = bits.begin() + static_cast<std::ptrdiff_t>(offset);
+  for (size_t j = 0; j < count; j++, ++it) {
+    *it = ((word >> j) & 1) != 0;
+  }
+}
+
+template <typename OutputIt>
+inline OutputIt pack_bit_vector(const vector<bool> &bits, size_t bit_count,
+                                bool is_msb_first, OutputIt output_it) {
+  for (size_t offset = 0; offset < bit_count; offset += 64) {
+    size_t count = std::min<size_t>(bit_count - offset, 64);
+    uint64_t word = bit_vector_word(bits, offset) & low_bits_mask(count);
+    output_it =
+        store_bitmap_word(word, (count + 7) / 8, is_msb_first, output_it);
+  }
+  return output_it;
+}
+
+}; // namespace detail
+
+/**
+ * @brief Pack a sequence of booleans into bytes, eight bits per byte. When
+ * `is_msb_first` is true the first bit is stored in the most significant bit
+ * of each byte, otherwise in the least significant bit. A partial final byte
+ * is written with its unused bits cleared.
+ */
+template <typename OutputIt>
+inline OutputIt bits_to_bytes(const bool *bits, size_t bit_count,
+                              bool is_msb_first, OutputIt output_it) {
+  if constexpr (std::is_same<OutputIt, uint8_t *>::value) {
+    detail::pack_bools(bits, bit_count, is_msb_first, output_it);
+    return output_it + (bit_count + 7) / 8;
+  } else {
+    uint8_t buffer[detail::bitmap_chunk_bytes];
+    for (size_t offset = 0; offset < bit_count;
+         offset += detail::bitmap_chunk_bytes * 8) {
+      size_t count =
+          std::min(bit_count - offset, detail::bitmap_chunk_bytes * 8);
+      detail::pack_bools(bits + offset, count, is_msb_first, buffer);
+      output_it = std::copy(buffer, buffer + (count + 7) / 8, output_it);
+    }
+    return output_it;
+  }
+}
+
+/**
+ * @brief Pack the bits of a `std::vector<bool>` into `(bits.size() + 7) / 8`
+ * bytes. With libstdc++ the bits are read a word at a time; other standard
+ * libraries expose no word access, so each bit goes through the proxy and the
+ * `bool` array overload is much faster there.
+ */
+template <typename OutputIt>
+inline OutputIt bits_to_bytes(const vector<bool> &bits, bool is_msb_first,
+                              OutputIt output_it) {
+  return detail::pack_bit_vector(bits, bits.size(), is_msb_first, output_it);
+}
+
+/**
+ * @brief Pack the bits of a `std::bitset` into `(N + 7) / 8` bytes, starting
+ * with bit position 0.
+ */
+template <size_t N, typename OutputIt>
+inline OutputIt bitset_to_bytes(const std::bitset<N> &bits, bool is_msb_first,
+                                OutputIt output_it) {
+  if constexpr (N <= 64) {
+    return detail::store_bitmap_word(bits.to_ullong(), (N + 7) / 8,
+                                     is_msb_first, output_it);
+  } else {
+    for (size_t offset = 0; offset < N; offset += 64) {
+      size_t count = std::min<size_t>(N - offset, 64);
+      uint64_t word = 0;
+      for (size_t j = 0; j < count; j++) {
+        word |= static_cast<uint64_t>(bits[offset + j]) << j;
+      }
+      output_it =
+          detail::store_bitmap_word(word, (count + 7) / 8, is_msb_first,
+                                    output_it);
+    }
+    return output_it;
+  }
+}
+
+/**
+ * @brief Unpack `bit_count` bits from `(bit_count + 7) / 8` bytes into an array
+ * of booleans.
+ */
+template <typename InputIt>
+inline void bytes_to_bits(InputIt input_it, size_t bit_count,
+                          bool is_msb_first, bool *bits) {
+  if constexpr (detail::is_byte_pointer<InputIt>::value) {
+    detail::unpack_bools(reinterpret_cast<const uint8_t *>(&*input_it),
+                         bit_count, is_msb_first, bits);
+  } else {
+    uint8_t buffer[detail::bitmap_chunk_bytes];
+    for (size_t offset = 0; offset < bit_count;
+         offset += detail::bitmap_chunk_bytes * 8) {
+      size_t count =
+          std::min(bit_count - offset, detail::bitmap_chunk_bytes * 8);
+      for (size_t k = 0; k < (count + 7) / 8; k++) {
+        buffer[k] = static_cast<uint8_t>(*input_it);
+        input_it++;
+      }
+      detail::unpack_bools(buffer, count, is_msb_first, bits + offset);
+    }
+  }
+}
+
+/**
+ * @brief Returns `bit_count` bits unpacked from `(bit_count + 7) / 8` bytes.
+ * Like the `std::vector<bool>` overload of `bits_to_bytes`, this stores whole
+ * words only with libstdc++.
+ */
+template <typename InputIt>
+inline vector<bool> bytes_to_bits(InputIt input_it, size_t bit_count,
+                                  bool is_msb_first) {
+  vector<bool> bits(bit_count);
+  for (size_t offset = 0; offset < bit_count; offset += 64) {
+    size_t count = std::min<size_t>(bit_count - offset, 64);
+    detail::set_bit_vector_word(
+        bits, offset,
+        detail::load_bitmap_word(input_it, (count + 7) / 8, is_msb_first));
+  }
+  return bits;
+}
+
+/**
+ * @brief Returns a `std::bitset` unpacked from `(N + 7) / 8` bytes.
+ */
+template <size_t N, typename InputIt>
+inline std::bitset<N> bytes_to_bitset(InputIt input_it, bool is_msb_first) {
+  if constexpr (N <= 64) {
+    return std::bitset<N>(
+        detail::load_bitmap_word(input_it, (N + 7) / 8, is_msb_first));
+  } else {
+    std::bitset<N> bits;
+    for (size_t offset = 0; offset < N; offset += 64) {
+      size_t count = std::min<size_t>(N - offset, 64);
+      uint64_t word =
+          detail::load_bitmap_word(input_it, (count + 7) / 8, is_msb_first);
+      for (size_t j = 0; j < count; j++) {
+        bits[offset + j] = ((word >> j) & 1) != 0;
+      }
+    }
+    return bits;
+  }
+}
+
+}; // namespace bit_converter
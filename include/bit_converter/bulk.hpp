@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "detail.hpp"
+#include "stats.hpp"
+
+namespace bit_converter {
+
+using std::size_t;
+
+namespace detail {
+
+constexpr size_t bulk_chunk_bytes = 4096;
+
+/**
+ * @brief Whether values stored in host order need their bytes reversed to be
+ * in the requested order.
+ */
+inline bool needs_byte_swap(bool is_big_endian) {
+  return is_big_endian == is_little_endian_host;
+}
+
+inline stats_path bulk_path(bool is_big_endian) {
+  return needs_byte_swap(is_big_endian) ? stats_path::bulk_swap
+                                        : stats_path::bulk_copy;
+}
+
+template <typename T>
+inline void encode_values(const T *values, size_t count, bool is_big_endian,
+                          uint8_t *output) {
+  using U = uint_of_size<T>;
+  if (!needs_byte_swap(is_big_endian)) {
+    std::memcpy(output, values, count * sizeof(T));
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    store_unaligned(output + i * sizeof(T),
+                    byte_swap(bit_cast<U>(values[i])));
+  }
+}
+
+template <typename T>
+inline void decode_values(const uint8_t *input, size_t count,
+                          bool is_big_endian, T *values) {
+  using U = uint_of_size<T>;
+  if (!needs_byte_swap(is_big_endian)) {
+    std::memcpy(values, input, count * sizeof(T));
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    values[i] =
+        bit_cast<T>(byte_swap(load_unaligned<U>(input + i * sizeof(T))));
+  }
+}
+
+template <typename T> struct is_bulk_type {
+  static constexpr bool value =
+      std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+      (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+};
+
+}; // namespace detail
+
+/**
+ * @brief Convert an array of integers or floating-point numbers to bytes, as
+ * the matching `*_to_bytes` function would do for each value in turn.
+ */
+template <typename T, typename OutputIt>
+inline OutputIt values_to_bytes(const T *values, size_t count,
+                                bool is_big_endian, OutputIt output_it) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "values_to_bytes needs an integer or floating-point type");
+  if constexpr (std::is_same<OutputIt, uint8_t *>::value) {
+    BIT_CONVERTER_COUNT(values_to_bytes, detail::bulk_path(is_big_endian),
+                        count, count * sizeof(T));
+    detail::encode_values(values, count, is_big_endian, output_it);
+    return output_it + count * sizeof(T);
+  } else {
+    BIT_CONVERTER_COUNT(values_to_bytes, stats_path::iterator, count,
+                        count * sizeof(T));
+    constexpr size_t chunk = detail::bulk_chunk_bytes / sizeof(T);
+    uint8_t buffer[detail::bulk_chunk_bytes];
+    for (size_t offset = 0; offset < count; offset += chunk) {
+      size_t n = std::min(count - offset, chunk);
+      detail::encode_values(values + offset, n, is_big_endian, buffer);
+      output_it = std::copy(buffer, buffer + n * sizeof(T), output_it);
+    }
+    return output_it;
+  }
+}
+
+/**
+ * @brief Convert `count * sizeof(T)` bytes to an array of integers or
+ * floating-point numbers, as the matching `bytes_to_*` function would do for
+ * each value in turn. Returns the position after the last value.
+ */
+template <typename T, typename InputIt>
+inline InputIt bytes_to_values(InputIt input_it, size_t count,
+                               bool is_big_endian, T *values) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "bytes_to_values needs an integer or floating-point type");
+  if constexpr (detail::is_byte_pointer<InputIt>::value) {
+    BIT_CONVERTER_COUNT(bytes_to_values, detail::bulk_path(is_big_endian),
+                        count, count * sizeof(T));
+    detail::decode_values(reinterpret_cast<const uint8_t *>(&*input_it), count,
+                          is_big_endian, values);
+    return input_it + count * sizeof(T);
+  } else {
+    BIT_CONVERTER_COUNT(bytes_to_values, stats_path::iterator, count,
+                        count * sizeof(T));
+    constexpr size_t chunk = detail::bulk_chunk_bytes / sizeof(T);
+    uint8_t buffer[detail::bulk_chunk_bytes];
+    for (size_t offset = 0; offset < count; offset += chunk) {
+      size_t n = std::min(count - offset, chunk);
+      for (size_t k = 0; k < n * sizeof(T); k++) {
+        buffer[k] = static_cast<uint8_t>(*input_it);
+        input_it++;
+      }
+      detail::decode_values(buffer, n, is_big_endian, values + offset);
+    }
+    return input_it;
+  }
+}
+
+}; // namespace bit_converter
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+namespace detail {
+
+/**
+ * @brief The CRC-32C (Castagnoli) polynomial in reflected bit order.
+ */
+constexpr uint32_t crc32c_polynomial = 0x82F63B78;
+
+/**
+ * @brief Tables for slicing by eight: `table[0]` advances the CRC by one
+ * byte, and `table[k]` by one byte followed by `k` zero bytes, so that eight
+ * bytes are folded in with eight independent lookups.
+ */
+struct crc32c_tables {
+  uint32_t table[8][256];
+
+  constexpr crc32c_tables() : table() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (crc32c_polynomial & (0 - (crc & 1)));
+      }
+      table[0][i] = crc;
+    }
+    for (int k = 1; k < 8; k++) {
+      for (uint32_t i = 0; i < 256; i++) {
+        uint32_t previous = table[k - 1][i];
+        table[k][i] = (previous >> 8) ^ table[0][previous & 0xFF];
+      }
+    }
+  }
+};
+
+inline const crc32c_tables &crc32c_lookup() {
+  static constexpr crc32c_tables tables;
+  return tables;
+}
+
+/**
+ * @brief Fold the bytes into a CRC register that is kept inverted, as the
+ * CRC-32C definition starts and ends with an inversion.
+ */
+inline uint32_t crc32c_update_table(uint32_t state, const uint8_t *data,
+                                    size_t size) {
+  const auto &t = crc32c_lookup().table;
+  for (; size >= 8; size -= 8, data += 8) {
+    uint64_t word = load_u64_le(data) ^ state;
+    state = t[7][word & 0xFF] ^ t[6][(word >> 8) & 0xFF] ^
+            t[5][(word >> 16) & 0xFF] ^ t[4][(word >> 24) & 0xFF] ^
+            t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF] ^
+            t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+  }
+  for (; size > 0; size--, data++) {
+    state = t[0][(state ^ *data) & 0xFF] ^ (state >> 8);
+  }
+  return state;
+}
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+
+/**
+ * @brief The bytes each of the three interleaved streams covers per round.
+ */
+constexpr size_t crc32c_stripe = 512;
+
+/**
+ * @brief Advances a CRC register over `crc32c_stripe` zero bytes with four
+ * lookups. The CRC update is linear, so the register after `A` followed by
+ * `B` is the register after `A` advanced over `|B|` zeros, xor the register
+ * after `B` alone; this joins the CRCs of separately computed stripes.
+ */
+struct crc32c_shift {
+  uint32_t table[4][256];
+
+  crc32c_shift() {
+    uint8_t zeros[crc32c_stripe] = {};
+    uint32_t basis[32];
+    for (int bit = 0; bit < 32; bit++) {
+      basis[bit] = crc32c_update_table(uint32_t(1) << bit, zeros, sizeof zeros);
+    }
+    for (int k = 0; k < 4; k++) {
+      for (uint32_t byte = 0; byte < 256; byte++) {
+        uint32_t shifted = 0;
+        for (int bit = 0; bit < 8; bit++) {
+          if (byte & (1U << bit)) {
+            shifted ^= basis[k * 8 + bit];
+          }
+        }
+        table[k][byte] = shifted;
+      }
+    }
+  }
+
+  uint32_t operator()(uint32_t crc) const {
+    return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^
+           table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24];
+  }
+};
+
+inline const crc32c_shift &crc32c_stripe_shift() {
+  static const crc32c_shift shift;
+  return shift;
+}
+
+/**
+ * @brief The `crc32` instruction has a latency of three cycles and a
+ * throughput of one per cycle, so long inputs are split into three stripes
+ * that are checksummed at once and then joined.
+ */
+inline uint32_t crc32c_update_sse42(uint32_t state, const uint8_t *data,
+                                    size_t size) {
+  if (size >= 3 * crc32c_stripe) {
+    const crc32c_shift &shift = crc32c_stripe_shift();
+    for (; size >= 3 * crc32c_stripe;
+         size -= 3 * crc32c_stripe, data += 3 * crc32c_stripe) {
+      uint64_t a = state;
+      uint64_t b = 0;
+      uint64_t c = 0;
+      for (size_t i = 0; i < crc32c_stripe; i += 8) {
+        a = _mm_crc32_u64(a, load_unaligned<uint64_t>(data + i));
+        b = _mm_crc32_u64(
+            b, load_unaligned<uint64_t>(data + crc32c_stripe + i));
+        c = _mm_crc32_u64(
+            c, load_unaligned<uint64_t>(data + 2 * crc32c_stripe + i));
+      }
+      state = shift(shift(static_cast<uint32_t>(a)) ^
+                    static_cast<uint32_t>(b)) ^
+              static_cast<uint32_t>(c);
+    }
+  }
+  uint64_t crc = state;
+  for (; size >= 8; size -= 8, data += 8) {
+    crc = _mm_crc32_u64(crc, load_unaligned<uint64_t>(data));
+  }
+  state = static_cast<uint32_t>(crc);
+  if (size >= 4) {
+    state = _mm_crc32_u32(state, load_unaligned<uint32_t>(data));
+    size -= 4;
+    data += 4;
+  }
+  for (; size > 0; size--, data++) {
+    state = _mm_crc32_u8(state, *data);
+  }
+  return state;
+}
+
+#endif
+
+/**
+ * @brief Use the SSE 4.2 `crc32` instruction when the code is compiled for
+ * it, and the tables otherwise.
+ */
+inline uint32_t crc32c_update(uint32_t state, const uint8_t *data,
+                              size_t size) {
+#if defined(__SSE4_2__) && defined(__x86_64__)
+  return crc32c_update_sse42(state, data, size);
+#else
+  return crc32c_update_table(state, data, size);
+#endif
+}
+
+}; // namespace detail
+
+/**
+ * @brief Returns the CRC-32C of the bytes. Passing the CRC of the preceding
+ * bytes as `crc` continues it, so a message can be checksummed in pieces.
+ */
+inline uint32_t crc32c(const void *data, size_t size, uint32_t crc = 0) {
+  return ~detail::crc32c_update(~crc, static_cast<const uint8_t *>(data),
+                                size);
+}
+
+/**
+ * @brief Encodes values into a caller's buffer and keeps the CRC-32C of
+ * everything written so far. Each value or chunk of values is checksummed
+ * right after it is encoded, while its bytes are still in the L1 cache,
+ * rather than in a second pass over the whole frame.
+ */
+class crc32c_writer {
+public:
+  /**
+   * @brief Write to `output`, continuing the CRC `crc` of any bytes before
+   * it.
+   */
+  explicit crc32c_writer(uint8_t *output, uint32_t crc = 0)
+      : start(output), cursor(output), state(~crc) {}
+
+  template <typename T> void write_value(T value, bool is_big_endian) {
+    uint8_t *target = cursor;
+    cursor = values_to_bytes(&value, 1, is_big_endian, cursor);
+    state = detail::crc32c_update(state, target, sizeof(T));
+  }
+
+  template <typename T>
+  void write_values(const T *values, size_t count, bool is_big_endian) {
+    constexpr size_t chunk = detail::bulk_chunk_bytes / sizeof(T);
+    for (size_t offset = 0; offset < count; offset += chunk) {
+      size_t n = std::min(count - offset, chunk);
+      uint8_t *target = cursor;
+      cursor = values_to_bytes(values + offset, n, is_big_endian, cursor);
+      state = detail::crc32c_update(state, target, n * sizeof(T));
+    }
+  }
+
+  void write(const void *data, size_t size) {
+    std::memcpy(cursor, data, size);
+    state = detail::crc32c_update(state, cursor, size);
+    cursor += size;
+  }
+
+  /**
+   * @brief The CRC-32C of the bytes written so far.
+   */
+  uint32_t checksum() const { return ~state; }
+
+  /**
+   * @brief The position after the last byte written.
+   */
+  uint8_t *position() const { return cursor; }
+
+  size_t size() const { return static_cast<size_t>(cursor - start); }
+
+private:
+  uint8_t *start;
+  uint8_t *cursor;
+  uint32_t state;
+};
+
+/**
+ * @brief Decodes values from a buffer and keeps the CRC-32C of everything
+ * read so far, checksumming each chunk as it is decoded.
+ */
+class crc32c_reader {
+public:
+  crc32c_reader(const uint8_t *data, size_t size, uint32_t crc = 0)
+      : cursor(data), end(data + size), state(~crc) {}
+
+  /**
+   * @brief Decode one value. Returns false, reading nothing, when fewer
+   * than `sizeof(T)` bytes are left.
+   */
+  template <typename T> bool read_value(T &value, bool is_big_endian) {
+    if (remaining() < sizeof(T)) {
+      return false;
+    }
+    state = detail::crc32c_update(state, cursor, sizeof(T));
+    cursor = bytes_to_values(cursor, 1, is_big_endian, &value);
+    return true;
+  }
+
+  /**
+   * @brief Decode up to `count` values and return how many were read.
+   */
+  template <typename T>
+  size_t read_values(T *values, size_t count, bool is_big_endian) {
+    count = std::min(count, remaining() / sizeof(T));
+    constexpr size_t chunk = detail::bulk_chunk_bytes / sizeof(T);
+    for (size_t offset = 0; offset < count; offset += chunk) {
+      size_t n = std::min(count - offset, chunk);
+      state = detail::crc32c_update(state, cursor, n * sizeof(T));
+      cursor = bytes_to_values(cursor, n, is_big_endian, values + offset);
+    }
+    return count;
+  }
+
+  /**
+   * @brief Copy `size` bytes. Returns false, reading nothing, when fewer are
+   * left.
+   */
+  bool read(void *output, size_t size) {
+    if (remaining() < size) {
+      return false;
+    }
+    std::memcpy(output, cursor, size);
+    state = detail::crc32c_update(state, cursor, size);
+    cursor += size;
+    return true;
+  }
+
+  /**
+   * @brief The CRC-32C of the bytes read so far.
+   */
+  uint32_t checksum() const { return ~state; }
+
+  const uint8_t *position() const { return cursor; }
+
+  size_t remaining() const { return static_cast<size_t>(end - cursor); }
+
+private:
+  const uint8_t *cursor;
+  const uint8_t *end;
+  uint32_t state;
+};
+
+}; // namespace bit_converter
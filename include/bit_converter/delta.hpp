@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "bit_converter.hpp"
+#include "varint.hpp"
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace bit_converter {
+
+namespace detail {
+
+constexpr size_t delta_chunk_size = 256;
+
+/**
+ * @brief Store the wrapping sum of every element and all the elements before
+ * it, starting from `carry`. `output` may be the same array as `input`.
+ * Returns the last sum.
+ */
+inline uint64_t prefix_sum(const uint64_t *input, size_t count,
+                           uint64_t *output, uint64_t carry) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  __m256i sum = _mm256_set1_epi64x(static_cast<int64_t>(carry));
+  const __m256i zero = _mm256_setzero_si256();
+  for (; i + 4 <= count; i += 4) {
+    __m256i x =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i));
+    // [x0, x1, x2, x3] -> [x0, x0 + x1, x1 + x2, x2 + x3]
+    x = _mm256_add_epi64(
+        x, _mm256_blend_epi32(
+               _mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)), zero,
+               0x03));
+    // -> [x0, x0 + x1, x0 + x1 + x2, x0 + x1 + x2 + x3]
+    x = _mm256_add_epi64(
+        x, _mm256_blend_epi32(
+               _mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)), zero,
+               0x0F));
+    x = _mm256_add_epi64(x, sum);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i), x);
+    sum = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+  }
+  if (i > 0) {
+    carry = output[i - 1];
+  }
+#elif defined(__SSE2__)
+  __m128i sum = _mm_set1_epi64x(static_cast<int64_t>(carry));
+  for (; i + 2 <= count; i += 2) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i));
+    x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi64(x, sum);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), x);
+    sum = _mm_unpackhi_epi64(x, x);
+  }
+  if (i > 0) {
+    carry = output[i - 1];
+  }
+#endif
+  for (; i < count; i++) {
+    carry = carry + input[i];
+    output[i] = carry;
+  }
+  return carry;
+}
+
+inline const uint64_t *as_unsigned(const int64_t *values) {
+  return reinterpret_cast<const uint64_t *>(values);
+}
+
+inline uint64_t *as_unsigned(int64_t *values) {
+  return reinterpret_cast<uint64_t *>(values);
+}
+
+}; // namespace detail
+
+/**
+ * @brief Replace each value with its difference from the previous one. The
+ * first value is kept as is. `deltas` may be the same array as `values`.
+ */
+inline void delta_encode(const int64_t *values, size_t count,
+                         int64_t *deltas) {
+  uint64_t previous = 0;
+  for (size_t i = 0; i < count; i++) {
+    uint64_t current = static_cast<uint64_t>(values[i]);
+    deltas[i] = static_cast<int64_t>(current - previous);
+    previous = current;
+  }
+}
+
+/**
+ * @brief The inverse of `delta_encode`. `values` may be the same array as
+ * `deltas`.
+ */
+inline void delta_decode(const int64_t *deltas, size_t count,
+                         int64_t *values) {
+  detail::prefix_sum(detail::as_unsigned(deltas), count,
+                     detail::as_unsigned(values), 0);
+}
+
+/**
+ * @brief Replace each value with the difference between its delta and the
+ * previous delta. The first value and the first delta are kept as is, so a
+ * series with a constant interval encodes to zeros after the second element.
+ * `deltas` may be the same array as `values`.
+ */
+inline void delta_of_delta_encode(const int64_t *values, size_t count,
+                                  int64_t *deltas) {
+  uint64_t previous = 0;
+  uint64_t previous_delta = 0;
+  for (size_t i = 0; i < count; i++) {
+    uint64_t current = static_cast<uint64_t>(values[i]);
+    uint64_t delta = current - previous;
+    deltas[i] = static_cast<int64_t>(i == 0 ? current : delta - previous_delta);
+    previous = current;
+    previous_delta = i == 0 ? 0 : delta;
+  }
+}
+
+/**
+ * @brief The inverse of `delta_of_delta_encode`. `values` may be the same
+ * array as `deltas`.
+ */
+inline void delta_of_delta_decode(const int64_t *deltas, size_t count,
+                                  int64_t *values) {
+  if (count == 0) {
+    return;
+  }
+  // Starting the first pass at -first turns the first element into a zero
+  // delta, and the second pass adds the first value back to every element.
+  uint64_t first = static_cast<uint64_t>(deltas[0]);
+  detail::prefix_sum(detail::as_unsigned(deltas), count,
+                     detail::as_unsigned(values), 0 - first);
+  detail::prefix_sum(detail::as_unsigned(values), count,
+                     detail::as_unsigned(values), first);
+}
+
+namespace detail {
+
+/**
+ * @brief Encode the values chunk by chunk so that the transform and the byte
+ * conversion share a small buffer that stays in cache.
+ */
+template <typename Encode, typename OutputIt>
+inline OutputIt encode_deltas(const int64_t *values, size_t count,
+                              bool is_delta_of_delta, Encode encode,
+                              OutputIt output_it) {
+  int64_t buffer[delta_chunk_size + 2];
+  for (size_t offset = 0; offset < count; offset += delta_chunk_size) {
+    size_t n = std::min(count - offset, delta_chunk_size);
+    // Recompute from up to two earlier values so the chunks join seamlessly.
+    size_t history = std::min<size_t>(offset, is_delta_of_delta ? 2 : 1);
+    const int64_t *source = values + offset - history;
+    if (is_delta_of_delta) {
+      delta_of_delta_encode(source, n + history, buffer);
+    } else {
+      delta_encode(source, n + history, buffer);
+    }
+    for (size_t i = history; i < n + history; i++) {
+      output_it = encode(buffer[i], output_it);
+    }
+  }
+  return output_it;
+}
+
+/**
+ * @brief Decode chunk by chunk and run the prefix sums while the chunk is
+ * still in cache.
+ */
+template <typename Decode, typename InputIt>
+inline InputIt decode_deltas(InputIt input_it, size_t count,
+                             bool is_delta_of_delta, Decode decode,
+                             int64_t *values) {
+  uint64_t value_carry = 0;
+  uint64_t delta_carry = 0;
+  for (size_t offset = 0; offset < count; offset += delta_chunk_size) {
+    size_t n = std::min(count - offset, delta_chunk_size);
+    for (size_t i = 0; i < n; i++) {
+      input_it = decode(input_it, values[offset + i]);
+    }
+    uint64_t *chunk = as_unsigned(values + offset);
+    if (is_delta_of_delta) {
+      // The very first element is the initial value rather than a delta.
+      size_t skip = offset == 0 ? 1 : 0;
+      if (n > skip) {
+        delta_carry =
+            prefix_sum(chunk + skip, n - skip, chunk + skip, delta_carry);
+      }
+    }
+    value_carry = prefix_sum(chunk, n, chunk, value_carry);
+  }
+  return input_it;
+}
+
+template <typename OutputIt> struct fixed_width_encoder {
+  bool is_big_endian;
+  OutputIt operator()(int64_t value, OutputIt output_it) const {
+    return i64_to_bytes(value, is_big_endian, output_it);
+  }
+};
+
+template <typename InputIt> struct fixed_width_decoder {
+  bool is_big_endian;
+  InputIt operator()(InputIt input_it, int64_t &value) const {
+    value = bytes_to_i64(input_it, is_big_endian);
+    std::advance(input_it, sizeof(int64_t));
+    return input_it;
+  }
+};
+
+template <typename OutputIt> struct varint_encoder {
+  OutputIt operator()(int64_t value, OutputIt output_it) const {
+    return i64_to_varint(value, output_it);
+  }
+};
+
+template <typename InputIt> struct varint_decoder {
+  InputIt operator()(InputIt input_it, int64_t &value) const {
+    return varint_to_i64(input_it, value);
+  }
+};
+
+}; // namespace detail
+
+/**
+ * @brief Delta encode the values and convert every delta to eight bytes.
+ */
+template <typename OutputIt>
+inline OutputIt delta_to_bytes(const int64_t *values, size_t count,
+                               bool is_big_endian, OutputIt output_it) {
+  return detail::encode_deltas(values, count, false,
+                               detail::fixed_width_encoder<OutputIt>{
+                                   is_big_endian},
+                               output_it);
+}
+
+/**
+ * @brief Read `count` deltas written by `delta_to_bytes` and restore the
+ * values. Returns the position after the last delta.
+ */
+template <typename InputIt>
+inline InputIt bytes_to_delta(InputIt input_it, size_t count,
+                              bool is_big_endian, int64_t *values) {
+  return detail::decode_deltas(
+      input_it, count, false,
+      detail::fixed_width_decoder<InputIt>{is_big_endian}, values);
+}
+
+/**
+ * @brief Delta encode the values and convert every delta to a zigzag varint.
+ */
+template <typename OutputIt>
+inline OutputIt delta_to_varints(const int64_t *values, size_t count,
+                                 OutputIt output_it) {
+  return detail::encode_deltas(values, count, false,
+                               detail::varint_encoder<OutputIt>{}, output_it);
+}
+
+/**
+ * @brief Read `count` varints written by `delta_to_varints` and restore the
+ * values. Returns the position after the last varint.
+ */
+template <typename InputIt>
+inline InputIt varints_to_delta(InputIt input_it, size_t count,
+                                int64_t *values) {
+  return detail::decode_deltas(input_it, count, false,
+                               detail::varint_decoder<InputIt>{}, values);
+}
+
+/**
+ * @brief Delta-of-delta encode the values and convert every result to eight
+ * bytes.
+ */
+template <typename OutputIt>
+inline OutputIt delta_of_delta_to_bytes(const int64_t *values, size_t count,
+                                        bool is_big_endian,
+                                        OutputIt output_it) {
+  return detail::encode_deltas(values, count, true,
+                               detail::fixed_width_encoder<OutputIt>{
+                                   is_big_endian},
+                               output_it);
+}
+
+/**
+ * @brief Read `count` values written by `delta_of_delta_to_bytes` and restore
+ * the series. Returns the position after the last value.
+ */
+template <typename InputIt>
+inline InputIt bytes_to_delta_of_delta(InputIt input_it, size_t count,
+                                       bool is_big_endian, int64_t *values) {
+  return detail::decode_deltas(
+      input_it, count, true,
+      detail::fixed_width_decoder<InputIt>{is_big_endian}, values);
+}
+
+/**
+ * @brief Delta-of-delta encode the values and convert every result to a
+ * zigzag varint. A series sampled at a steady interval costs about one byte
+ * per value.
+ */
+template <typename OutputIt>
+inline OutputIt delta_of_delta_to_varints(const int64_t *values, size_t count,
+                                          OutputIt output_it) {
+  return detail::encode_deltas(values, count, true,
+                               detail::varint_encoder<OutputIt>{}, output_it);
+}
+
+/**
+ * @brief Read `count` varints written by `delta_of_delta_to_varints` and
+ * restore the series. Returns the position after the last varint.
+ */
+template <typename InputIt>
+inline InputIt varints_to_delta_of_delta(InputIt input_it, size_t count,
+                                         int64_t *values) {
+  return detail::decode_deltas(input_it, count, true,
+                               detail::varint_decoder<InputIt>{}, values);
+}
+
+}; // namespace bit_converter
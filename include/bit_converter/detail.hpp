@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+namespace bit_converter {
+
+namespace detail {
+
+using std::size_t;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool is_little_endian_host = false;
+#else
+constexpr bool is_little_endian_host = true;
+#endif
+
+inline uint8_t byte_swap(uint8_t value) { return value; }
+
+inline uint16_t byte_swap(uint16_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap16(value);
+#elif defined(_MSC_VER)
+  return _byteswap_ushort(value);
+#else
+  return static_cast<uint16_t>((value << 8) | (value >> 8));
+#endif
+}
+
+inline uint32_t byte_swap(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap32(value);
+#elif defined(_MSC_VER)
+  return _byteswap_ulong(value);
+#else
+  return ((value & 0x000000FFU) << 24) | ((value & 0x0000FF00U) << 8) |
+         ((value & 0x00FF0000U) >> 8) | ((value & 0xFF000000U) >> 24);
+#endif
+}
+
+inline uint64_t byte_swap(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+  return _byteswap_uint64(value);
+#else
+  return (static_cast<uint64_t>(byte_swap(static_cast<uint32_t>(value)))
+          << 32) |
+         byte_swap(static_cast<uint32_t>(value >> 32));
+#endif
+}
+
+inline int count_leading_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return value == 0 ? 64 : __builtin_clzll(value);
+#else
+  int count = 0;
+  for (uint64_t bit = 1ULL << 63; bit != 0 && (value & bit) == 0; bit >>= 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+inline int count_trailing_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return value == 0 ? 64 : __builtin_ctzll(value);
+#else
+  int count = 0;
+  for (uint64_t bit = 1; bit != 0 && (value & bit) == 0; bit <<= 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+inline int popcount(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(value);
+#else
+  int count = 0;
+  for (; value != 0; value &= value - 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+/**
+ * @brief Reverse the order of the bits inside every byte of the word.
+ */
+inline uint64_t reverse_bits_in_bytes(uint64_t value) {
+  value = ((value >> 1) & 0x5555555555555555ULL) |
+          ((value & 0x5555555555555555ULL) << 1);
+  value = ((value >> 2) & 0x3333333333333333ULL) |
+          ((value & 0x3333333333333333ULL) << 2);
+  value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) |
+          ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+  return value;
+}
+
+/**
+ * @brief Whether the iterator is a plain pointer to bytes, which allows
+ * copying whole ranges with `memcpy`.
+ */
+template <typename It>
+using is_byte_pointer =
+    std::integral_constant<bool, std::is_pointer<It>::value &&
+                                     sizeof(decltype(*std::declval<It>())) ==
+                                         1>;
+
+template <size_t N> struct uint_of_size_impl;
+template <> struct uint_of_size_impl<1> { using type = uint8_t; };
+template <> struct uint_of_size_impl<2> { using type = uint16_t; };
+template <> struct uint_of_size_impl<4> { using type = uint32_t; };
+template <> struct uint_of_size_impl<8> { using type = uint64_t; };
+
+/**
+ * @brief The unsigned integer type with the same size as `T`.
+ */
+template <typename T>
+using uint_of_size = typename uint_of_size_impl<sizeof(T)>::type;
+
+/**
+ * @brief Reinterpret the object representation of `value` as type `To`.
+ */
+template <typename To, typename From> inline To bit_cast(const From &value) {
+  static_assert(sizeof(To) == sizeof(From), "bit_cast needs equal sizes");
+  To result;
+  std::memcpy(&result, &value, sizeof(To));
+  return result;
+}
+
+template <typename T> inline T load_unaligned(const void *source) {
+  T value;
+  std::memcpy(&value, source, sizeof(T));
+  return value;
+}
+
+template <typename T> inline void store_unaligned(void *target, T value) {
+  std::memcpy(target, &value, sizeof(T));
+}
+
+/**
+ * @brief Load a little-endian 64-bit word regardless of the host byte order.
+ */
+inline uint64_t load_u64_le(const uint8_t *source) {
+  uint64_t value = load_unaligned<uint64_t>(source);
+  return is_little_endian_host ? value : byte_swap(value);
+}
+
+/**
+ * @brief Store a 64-bit word in little-endian order regardless of the host
+ * byte order.
+ */
+inline void store_u64_le(uint8_t *target, uint64_t value) {
+  store_unaligned(target, is_little_endian_host ? value : byte_swap(value));
+}
+
+}; // namespace detail
+
+}; // namespace bit_converter
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+/**
+ * @brief Writes converted values to a file through two large aligned blocks.
+ * Values are encoded straight into the current block; a full block is handed
+ * to a background thread that writes it with `pwrite` while the caller fills
+ * the other one.
+ *
+ * Errors are sticky: after the first failure further writes are ignored,
+ * `error` returns the `errno` value and `close` returns false.
+ */
+class file_sink {
+public:
+  struct options {
+    // A non-zero multiple of `direct_io_alignment`; anything else fails with
+    // EINVAL.
+    size_t block_size = 4 << 20;
+    // Bypass the page cache with O_DIRECT where the file system allows it.
+    bool use_direct_io = false;
+  };
+
+  static constexpr size_t direct_io_alignment = 4096;
+
+  explicit file_sink(const char *path) : file_sink(path, options()) {}
+
+  file_sink(const char *path, const options &config)
+      : block_size(config.block_size) {
+    if (block_size == 0 || block_size % direct_io_alignment != 0) {
+      failure = EINVAL;
+      return;
+    }
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#if defined(O_DIRECT)
+    if (config.use_direct_io) {
+      fd = ::open(path, flags | O_DIRECT, 0644);
+      is_direct = fd >= 0;
+    }
+#endif
+    if (fd < 0) {
+      fd = ::open(path, flags, 0644);
+    }
+    if (fd < 0) {
+      failure = errno;
+      return;
+    }
+    for (auto &block : blocks) {
+      block = static_cast<uint8_t *>(
+          std::aligned_alloc(direct_io_alignment, block_size));
+      if (block == nullptr) {
+        failure = ENOMEM;
+        ::close(fd);
+        fd = -1;
+        return;
+      }
+    }
+    writer = std::thread([this] { write_blocks(); });
+  }
+
+  file_sink(const file_sink &) = delete;
+  file_sink &operator=(const file_sink &) = delete;
+
+  ~file_sink() {
+    close();
+    for (auto &block : blocks) {
+      std::free(block);
+    }
+  }
+
+  bool is_open() const { return fd >= 0; }
+
+  int error() const { return failure; }
+
+  /**
+   * @brief Convert the values and append them to the file.
+   */
+  template <typename T>
+  void write_values(const T *values, size_t count, bool is_big_endian) {
+    while (count > 0 && is_writable()) {
+      size_t n = std::min(count, (block_size - used) / sizeof(T));
+      if (n == 0) {
+        // The next value straddles two blocks.
+        uint8_t bytes[sizeof(T)];
+        values_to_bytes(values, 1, is_big_endian, bytes);
+        write_bytes(bytes, sizeof(T));
+        n = 1;
+      } else {
+        values_to_bytes(values, n, is_big_endian, blocks[current] + used);
+        advance(n * sizeof(T));
+      }
+      values += n;
+      count -= n;
+    }
+  }
+
+  /**
+   * @brief Append raw bytes to the file.
+   */
+  void write_bytes(const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    while (size > 0 && is_writable()) {
+      size_t n = std::min(size, block_size - used);
+      std::memcpy(blocks[current] + used, bytes, n);
+      advance(n);
+      bytes += n;
+      size -= n;
+    }
+  }
+
+  /**
+   * @brief Write the last partial block, wait for the writer and close the
+   * file. Returns false if any write failed.
+   */
+  bool close() {
+    if (fd < 0) {
+      return failure == 0;
+    }
+    size_t size = file_size + used;
+    if (used > 0 && is_writable()) {
+      if (is_direct) {
+        // O_DIRECT needs whole aligned blocks; the padding is truncated below.
+        size_t padded = (used + direct_io_alignment - 1) /
+                        direct_io_alignment * direct_io_alignment;
+        std::memset(blocks[current] + used, 0, padded - used);
+        used = padded;
+      }
+      submit();
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      idle.wait(lock, [this] { return !is_busy; });
+      is_stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+    if (is_direct && failure == 0 &&
+        ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      failure = errno;
+    }
+    if (::close(fd) != 0 && failure == 0) {
+      failure = errno;
+    }
+    fd = -1;
+    return failure == 0;
+  }
+
+private:
+  bool is_writable() const { return fd >= 0 && failure == 0; }
+
+  void advance(size_t size) {
+    used += size;
+    if (used == block_size) {
+      submit();
+    }
+  }
+
+  /**
+   * @brief Hand the current block to the writer thread and switch to the
+   * other one once its previous write has finished.
+   */
+  void submit() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !is_busy; });
+    job_block = blocks[current];
+    job_size = used;
+    job_offset = file_size;
+    is_busy = true;
+    lock.unlock();
+    wake.notify_one();
+    file_size += used;
+    current = 1 - current;
+    used = 0;
+  }
+
+  void write_blocks() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      wake.wait(lock, [this] { return is_busy || is_stopping; });
+      if (!is_busy) {
+        return;
+      }
+      const uint8_t *data = job_block;
+      size_t size = job_size;
+      size_t offset = job_offset;
+      lock.unlock();
+      int result = write_all(data, size, offset);
+      lock.lock();
+      if (result != 0 && failure == 0) {
+        failure = result;
+      }
+      is_busy = false;
+      idle.notify_one();
+    }
+  }
+
+  int write_all(const uint8_t *data, size_t size, size_t offset) {
+    while (size > 0) {
+      ssize_t written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return errno;
+      }
+      data += written;
+      size -= static_cast<size_t>(written);
+      offset += static_cast<size_t>(written);
+    }
+    return 0;
+  }
+
+  size_t block_size;
+  int fd = -1;
+  bool is_direct = false;
+  uint8_t *blocks[2] = {nullptr, nullptr};
+  int current = 0;
+  size_t used = 0;
+  size_t file_size = 0;
+
+  std::thread writer;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable idle;
+  const uint8_t *job_block = nullptr;
+  size_t job_size = 0;
+  size_t job_offset = 0;
+  bool is_busy = false;
+  bool is_stopping = false;
+  std::atomic<int> failure{0};
+};
+
+}; // namespace bit_converter
@@ -0,0 +1,551 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define BIT_CONVERTER_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#include "stream.hpp"
+
+namespace bit_converter {
+
+namespace detail {
+
+/**
+ * @brief One block read into one of the buffers of a `file_source`.
+ */
+struct read_request {
+  uint8_t *data = nullptr;
+  size_t size = 0;
+  size_t offset = 0;
+  size_t filled = 0;
+  int error = 0;
+  bool is_submitted = false;
+  bool is_done = false;
+  iovec vector = {};
+};
+
+#if defined(BIT_CONVERTER_HAS_IO_URING)
+
+/**
+ * @brief A minimal io_uring submission and completion queue, set up with raw
+ * system calls so that no liburing is needed.
+ */
+class io_uring_queue {
+public:
+  io_uring_queue() = default;
+  io_uring_queue(const io_uring_queue &) = delete;
+  io_uring_queue &operator=(const io_uring_queue &) = delete;
+
+  ~io_uring_queue() {
+    if (sqes != MAP_FAILED) {
+      ::munmap(sqes, sqes_size);
+    }
+    if (cq_ring != MAP_FAILED && cq_ring != sq_ring) {
+      ::munmap(cq_ring, cq_size);
+    }
+    if (sq_ring != MAP_FAILED) {
+      ::munmap(sq_ring, sq_size);
+    }
+    if (ring_fd >= 0) {
+      ::close(ring_fd);
+    }
+  }
+
+  /**
+   * @brief Create a ring for `depth` reads from `fd`. Returns false when the
+   * kernel does not provide io_uring or forbids it, e.g. in a container.
+   */
+  bool open(int fd, unsigned depth) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    long result = ::syscall(__NR_io_uring_setup, depth, &params);
+    if (result < 0) {
+      return false;
+    }
+    file_fd = fd;
+    ring_fd = static_cast<int>(result);
+    sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool is_single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (is_single_mmap) {
+      sq_size = cq_size = std::max(sq_size, cq_size);
+    }
+    sq_ring = map(sq_size, IORING_OFF_SQ_RING);
+    cq_ring = is_single_mmap ? sq_ring : map(cq_size, IORING_OFF_CQ_RING);
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = map(sqes_size, IORING_OFF_SQES);
+    if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED || sqes == MAP_FAILED) {
+      return false;
+    }
+    uint8_t *sq = static_cast<uint8_t *>(sq_ring);
+    uint8_t *cq = static_cast<uint8_t *>(cq_ring);
+    sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  /**
+   * @brief Queue a read of the unfilled part of `request`. It is passed to
+   * the kernel by the next `enter`.
+   */
+  void submit(read_request &request) {
+    unsigned tail = *sq_tail;
+    unsigned index = tail & sq_mask;
+    io_uring_sqe &sqe = static_cast<io_uring_sqe *>(sqes)[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    request.vector.iov_base = request.data + request.filled;
+    request.vector.iov_len = request.size - request.filled;
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = file_fd;
+    sqe.addr = reinterpret_cast<uint64_t>(&request.vector);
+    sqe.len = 1;
+    sqe.off = request.offset + request.filled;
+    sqe.user_data = reinterpret_cast<uint64_t>(&request);
+    sq_array[index] = index;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+    pending++;
+  }
+
+  /**
+   * @brief Pass the queued reads to the kernel and, when `waiting` is not
+   * null, block until that request is done. Returns 0 or an `errno` value.
+   */
+  int enter(read_request *waiting) {
+    for (;;) {
+      reap();
+      bool must_wait = waiting != nullptr && !waiting->is_done;
+      if (pending == 0 && !must_wait) {
+        return 0;
+      }
+      unsigned flags = must_wait ? IORING_ENTER_GETEVENTS : 0;
+      long result = ::syscall(__NR_io_uring_enter, ring_fd, pending,
+                              must_wait ? 1 : 0, flags, nullptr, 0);
+      if (result < 0) {
+        if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+          continue;
+        }
+        return errno;
+      }
+      pending -= static_cast<unsigned>(result);
+    }
+  }
+
+private:
+  void *map(size_t size, off_t offset) {
+    return ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+  }
+
+  void reap() {
+    unsigned head = *cq_head;
+    unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+      const io_uring_cqe &cqe = cqes[head & cq_mask];
+      complete(*reinterpret_cast<read_request *>(cqe.user_data), cqe.res);
+    }
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+  }
+
+  void complete(read_request &request, int result) {
+    if (result == -EINTR || result == -EAGAIN) {
+      submit(request);
+    } else if (result < 0) {
+      request.error = -result;
+      request.is_done = true;
+    } else if (result == 0) {
+      // The file shrank since it was opened.
+      request.is_done = true;
+    } else {
+      request.filled += static_cast<size_t>(result);
+      if (request.filled < request.size) {
+        submit(request);
+      } else {
+        request.is_done = true;
+      }
+    }
+  }
+
+  int file_fd = -1;
+  int ring_fd = -1;
+  void *sq_ring = MAP_FAILED;
+  void *cq_ring = MAP_FAILED;
+  void *sqes = MAP_FAILED;
+  size_t sq_size = 0;
+  size_t cq_size = 0;
+  size_t sqes_size = 0;
+  unsigned *sq_tail = nullptr;
+  unsigned sq_mask = 0;
+  unsigned *sq_array = nullptr;
+  unsigned *cq_head = nullptr;
+  unsigned *cq_tail = nullptr;
+  unsigned cq_mask = 0;
+  io_uring_cqe *cqes = nullptr;
+  unsigned pending = 0;
+};
+
+#endif
+
+/**
+ * @brief Reads blocks with `pread` on a set of threads, for systems without
+ * io_uring.
+ */
+class pread_queue {
+public:
+  pread_queue(int fd, size_t thread_count) : file_fd(fd) {
+    for (size_t i = 0; i < thread_count; i++) {
+      threads.emplace_back([this] { work(); });
+    }
+  }
+
+  pread_queue(const pread_queue &) = delete;
+  pread_queue &operator=(const pread_queue &) = delete;
+
+  ~pread_queue() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      is_stopping = true;
+    }
+    wake.notify_all();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  void submit(read_request &request) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push_back(&request);
+    }
+    wake.notify_one();
+  }
+
+  int enter(read_request *waiting) {
+    if (waiting != nullptr) {
+      std::unique_lock<std::mutex> lock(mutex);
+      done.wait(lock, [&] { return waiting->is_done; });
+    }
+    return 0;
+  }
+
+private:
+  void work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      wake.wait(lock, [this] { return is_stopping || !queue.empty(); });
+      if (queue.empty()) {
+        return;
+      }
+      read_request *request = queue.front();
+      queue.pop_front();
+      lock.unlock();
+      read_all(*request);
+      lock.lock();
+      request->is_done = true;
+      done.notify_all();
+    }
+  }
+
+  void read_all(read_request &request) {
+    while (request.filled < request.size) {
+      ssize_t result = ::pread(
+          file_fd, request.data + request.filled, request.size - request.filled,
+          static_cast<off_t>(request.offset + request.filled));
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        request.error = errno;
+        return;
+      }
+      if (result == 0) {
+        return;
+      }
+      request.filled += static_cast<size_t>(result);
+    }
+  }
+
+  int file_fd;
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  std::deque<read_request *> queue;
+  bool is_stopping = false;
+};
+
+}; // namespace detail
+
+/**
+ * @brief Reads a file block by block, in order, while keeping the next
+ * `queue_depth` blocks in flight. Reads go through io_uring when the kernel
+ * allows it and through a small pool of `pread` threads otherwise.
+ *
+ * Errors are sticky: `next_block` returns false after the first failure and
+ * `error` returns the `errno` value.
+ */
+class file_source {
+public:
+  struct options {
+    size_t block_size = 1 << 20;
+    // The number of blocks read ahead of the one being decoded.
+    size_t queue_depth = 4;
+    bool use_io_uring = true;
+  };
+
+  explicit file_source(const char *path) : file_source(path, options()) {}
+
+  file_source(const char *path, const options &config)
+      : block_size(std::max<size_t>(config.block_size, 1)) {
+    fd = ::open(path, O_RDONLY);
+    struct stat status;
+    if (fd < 0 || ::fstat(fd, &status) != 0) {
+      failure = errno;
+      return;
+    }
+    file_size = static_cast<size_t>(status.st_size);
+    requests.resize(std::max<size_t>(config.queue_depth, 1));
+    for (auto &request : requests) {
+      request.data = static_cast<uint8_t *>(
+          std::aligned_alloc(alignment, (block_size + alignment - 1) /
+                                            alignment * alignment));
+      if (request.data == nullptr) {
+        failure = ENOMEM;
+        return;
+      }
+    }
+#if defined(BIT_CONVERTER_HAS_IO_URING)
+    if (config.use_io_uring) {
+      ring.reset(new detail::io_uring_queue());
+      if (!ring->open(fd, static_cast<unsigned>(requests.size()))) {
+        ring.reset();
+      }
+    }
+    if (ring == nullptr)
+#endif
+    {
+      threads.reset(new detail::pread_queue(fd, requests.size()));
+    }
+    for (size_t i = 0; i < requests.size(); i++) {
+      request_block(i);
+    }
+    enter(nullptr);
+  }
+
+  file_source(const file_source &) = delete;
+  file_source &operator=(const file_source &) = delete;
+
+  ~file_source() {
+    // The kernel or the threads may still write into the buffers.
+    for (auto &request : requests) {
+      if (request.is_submitted) {
+        enter(&request);
+      }
+    }
+#if defined(BIT_CONVERTER_HAS_IO_URING)
+    ring.reset();
+#endif
+    threads.reset();
+    for (auto &request : requests) {
+      std::free(request.data);
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+  bool is_open() const { return fd >= 0; }
+
+  int error() const { return failure; }
+
+  /**
+   * @brief The size of the file when it was opened.
+   */
+  size_t size() const { return file_size; }
+
+  bool is_using_io_uring() const {
+#if defined(BIT_CONVERTER_HAS_IO_URING)
+    return ring != nullptr;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * @brief Point `data` and `size` at the next block of the file. The block
+   * stays valid until the next call. Returns false at the end of the file or
+   * after an error.
+   */
+  bool next_block(const uint8_t *&data, size_t &size) {
+    if (failure != 0) {
+      return false;
+    }
+    if (next > 0) {
+      // The previous block has been consumed; reuse its buffer.
+      request_block(next - 1 + requests.size());
+    }
+    detail::read_request &request = requests[next % requests.size()];
+    if (!request.is_submitted) {
+      return false;
+    }
+    int result = enter(&request);
+    request.is_submitted = false;
+    if (result == 0) {
+      result = request.error;
+    }
+    if (result != 0) {
+      failure = result;
+      return false;
+    }
+    next++;
+    data = request.data;
+    size = request.filled;
+    return true;
+  }
+
+private:
+  static constexpr size_t alignment = 4096;
+
+  void request_block(size_t index) {
+    size_t offset = index * block_size;
+    if (offset >= file_size) {
+      return;
+    }
+    detail::read_request &request = requests[index % requests.size()];
+    request.offset = offset;
+    request.size = std::min(block_size, file_size - offset);
+    request.filled = 0;
+    request.error = 0;
+    request.is_submitted = true;
+    request.is_done = false;
+#if defined(BIT_CONVERTER_HAS_IO_URING)
+    if (ring != nullptr) {
+      ring->submit(request);
+      return;
+    }
+#endif
+    threads->submit(request);
+  }
+
+  int enter(detail::read_request *waiting) {
+#if defined(BIT_CONVERTER_HAS_IO_URING)
+    if (ring != nullptr) {
+      return ring->enter(waiting);
+    }
+#endif
+    return threads != nullptr ? threads->enter(waiting) : 0;
+  }
+
+  size_t block_size;
+  int fd = -1;
+  size_t file_size = 0;
+  size_t next = 0;
+  int failure = 0;
+  std::vector<detail::read_request> requests;
+#if defined(BIT_CONVERTER_HAS_IO_URING)
+  std::unique_ptr<detail::io_uring_queue> ring;
+#endif
+  std::unique_ptr<detail::pread_queue> threads;
+};
+
+/**
+ * @brief Decodes the fixed-width values of a file in batches of up to one
+ * block, reading the following blocks while a batch is being processed.
+ */
+template <typename T> class file_decoder {
+public:
+  file_decoder(const char *path, bool is_big_endian)
+      : file_decoder(path, is_big_endian, file_source::options()) {}
+
+  file_decoder(const char *path, bool is_big_endian,
+               const file_source::options &config)
+      : source(path, config), decoder(is_big_endian),
+        batch(config.block_size / sizeof(T) + 1) {}
+
+  /**
+   * @brief Point `values` and `count` at the next batch of decoded values,
+   * which stays valid until the next call. Returns false at the end of the
+   * file or after an error.
+   */
+  bool next_batch(const T *&values, size_t &count) {
+    for (;;) {
+      if (!decoder.is_drained()) {
+        count = decoder.read(batch.data(), batch.size());
+        if (count > 0) {
+          values = batch.data();
+          return true;
+        }
+        continue;
+      }
+      const uint8_t *data;
+      size_t size;
+      if (!source.next_block(data, size)) {
+        if (source.error() == 0 && decoder.carried_bytes() > 0) {
+          // The file ends in the middle of a value.
+          failure = EINVAL;
+        }
+        return false;
+      }
+      decoder.feed(data, size);
+    }
+  }
+
+  int error() const { return source.error() != 0 ? source.error() : failure; }
+
+  bool is_using_io_uring() const { return source.is_using_io_uring(); }
+
+private:
+  file_source source;
+  stream_decoder<T> decoder;
+  std::vector<T> batch;
+  int failure = 0;
+};
+
+/**
+ * @brief Decode every value of the file at `path`, handing each batch to
+ * `on_batch(values, count)`. Returns 0 or an `errno` value.
+ */
+template <typename T, typename F>
+inline int decode_file(const char *path, bool is_big_endian, F &&on_batch,
+                       const file_source::options &config =
+                           file_source::options()) {
+  file_decoder<T> decoder(path, is_big_endian, config);
+  const T *values;
+  size_t count;
+  while (decoder.next_batch(values, count)) {
+    on_batch(values, count);
+  }
+  return decoder.error();
+}
+
+}; // namespace bit_converter
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+enum class comparison {
+  less,
+  less_equal,
+  equal,
+  greater,
+  greater_equal,
+  between
+};
+
+/**
+ * @brief A comparison of each value with a constant, or with two for
+ * `between`, which includes both bounds. As in C++, every comparison with a
+ * NaN is false.
+ */
+template <typename T> struct predicate {
+  comparison op;
+  T value;
+  // The upper bound of `between`.
+  T upper = T();
+};
+
+namespace detail {
+
+/**
+ * @brief The number of values whose results are packed into one bitmap word.
+ */
+constexpr size_t filter_word_size = 64;
+
+template <comparison Op, typename T>
+inline bool matches(T value, T low, T high) {
+  if constexpr (Op == comparison::less) {
+    return value < low;
+  } else if constexpr (Op == comparison::less_equal) {
+    return value <= low;
+  } else if constexpr (Op == comparison::equal) {
+    return value == low;
+  } else if constexpr (Op == comparison::greater) {
+    return value > low;
+  } else if constexpr (Op == comparison::greater_equal) {
+    return value >= low;
+  } else {
+    return value >= low && value <= high;
+  }
+}
+
+/**
+ * @brief Decode up to a word of values with the bulk decoder and return their
+ * results as a bitmap word.
+ */
+template <comparison Op, typename T>
+inline uint64_t match_scalar(const uint8_t *input, size_t n,
+                             bool is_big_endian, T low, T high) {
+  T values[filter_word_size];
+  decode_values(input, n, is_big_endian, values);
+  uint64_t mask = 0;
+  for (size_t i = 0; i < n; i++) {
+    mask |= static_cast<uint64_t>(matches<Op>(values[i], low, high)) << i;
+  }
+  return mask;
+}
+
+#if defined(__AVX2__)
+
+template <size_t Size, bool Swap>
+inline __m256i load_lanes(const uint8_t *input) {
+  __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input));
+  if (Swap) {
+    const __m256i reverse =
+        Size == 4 ? _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15,
+                                     14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11,
+                                     10, 9, 8, 15, 14, 13, 12)
+                  : _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12,
+                                     11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15,
+                                     14, 13, 12, 11, 10, 9, 8);
+    v = _mm256_shuffle_epi8(v, reverse);
+  }
+  return v;
+}
+
+inline __m256i greater_lanes(__m256i a, __m256i b, int32_t) {
+  return _mm256_cmpgt_epi32(a, b);
+}
+inline __m256i greater_lanes(__m256i a, __m256i b, int64_t) {
+  return _mm256_cmpgt_epi64(a, b);
+}
+inline __m256i equal_lanes(__m256i a, __m256i b, int32_t) {
+  return _mm256_cmpeq_epi32(a, b);
+}
+inline __m256i equal_lanes(__m256i a, __m256i b, int64_t) {
+  return _mm256_cmpeq_epi64(a, b);
+}
+inline __m256i broadcast(int32_t value) { return _mm256_set1_epi32(value); }
+inline __m256i broadcast(int64_t value) { return _mm256_set1_epi64x(value); }
+inline unsigned lane_bits(__m256i mask, int32_t) {
+  return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+}
+inline unsigned lane_bits(__m256i mask, int64_t) {
+  return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+}
+
+template <comparison Op, typename T>
+inline unsigned match_lanes(__m256i v, __m256i low, __m256i high) {
+  const __m256i ones = _mm256_set1_epi32(-1);
+  __m256i mask;
+  if constexpr (Op == comparison::less) {
+    mask = greater_lanes(low, v, T());
+  } else if constexpr (Op == comparison::less_equal) {
+    mask = _mm256_xor_si256(greater_lanes(v, low, T()), ones);
+  } else if constexpr (Op == comparison::equal) {
+    mask = equal_lanes(v, low, T());
+  } else if constexpr (Op == comparison::greater) {
+    mask = greater_lanes(v, low, T());
+  } else if constexpr (Op == comparison::greater_equal) {
+    mask = _mm256_xor_si256(greater_lanes(low, v, T()), ones);
+  } else {
+    mask = _mm256_xor_si256(_mm256_or_si256(greater_lanes(low, v, T()),
+                                            greater_lanes(v, high, T())),
+                            ones);
+  }
+  return lane_bits(mask, T());
+}
+
+template <comparison Op> constexpr int float_predicate() {
+  return Op == comparison::less            ? _CMP_LT_OQ
+         : Op == comparison::less_equal    ? _CMP_LE_OQ
+         : Op == comparison::equal         ? _CMP_EQ_OQ
+         : Op == comparison::greater       ? _CMP_GT_OQ
+         : Op == comparison::greater_equal ? _CMP_GE_OQ
+                                           : _CMP_GE_OQ;
+}
+
+template <comparison Op, typename T>
+inline unsigned match_float_lanes(__m256i raw, T low, T high) {
+  // A constant expression, so the immediate also compiles at -O0.
+  constexpr int predicate = float_predicate<Op>();
+  if constexpr (sizeof(T) == 4) {
+    __m256 v = _mm256_castsi256_ps(raw);
+    __m256 mask = _mm256_cmp_ps(v, _mm256_set1_ps(low), predicate);
+    if (Op == comparison::between) {
+      mask = _mm256_and_ps(
+          mask, _mm256_cmp_ps(v, _mm256_set1_ps(high), _CMP_LE_OQ));
+    }
+    return static_cast<unsigned>(_mm256_movemask_ps(mask));
+  } else {
+    __m256d v = _mm256_castsi256_pd(raw);
+    __m256d mask = _mm256_cmp_pd(v, _mm256_set1_pd(low), predicate);
+    if (Op == comparison::between) {
+      mask = _mm256_and_pd(
+          mask, _mm256_cmp_pd(v, _mm256_set1_pd(high), _CMP_LE_OQ));
+    }
+    return static_cast<unsigned>(_mm256_movemask_pd(mask));
+  }
+}
+
+template <typename T>
+using is_avx2_filter_type = std::integral_constant<
+    bool, std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value ||
+              std::is_same<T, float>::value || std::is_same<T, double>::value>;
+
+/**
+ * @brief Compare a word of values in registers, straight from the encoded
+ * bytes, and collect the lane masks with `movemask`.
+ */
+template <comparison Op, bool Swap, typename T>
+inline uint64_t match_avx2(const uint8_t *input, T low, T high) {
+  constexpr size_t lanes = 32 / sizeof(T);
+  uint64_t mask = 0;
+  for (size_t k = 0; k < filter_word_size / lanes; k++) {
+    __m256i raw = load_lanes<sizeof(T), Swap>(input + k * 32);
+    unsigned bits;
+    if constexpr (std::is_floating_point<T>::value) {
+      bits = match_float_lanes<Op>(raw, low, high);
+    } else {
+      bits = match_lanes<Op, T>(raw, broadcast(low), broadcast(high));
+    }
+    mask |= static_cast<uint64_t>(bits) << (k * lanes);
+  }
+  return mask;
+}
+
+#endif
+
+template <comparison Op, bool Swap, typename T, typename F>
+inline void match_words(const uint8_t *input, size_t count, bool is_big_endian,
+                        T low, T high, F &on_word) {
+  size_t word = 0;
+  size_t offset = 0;
+  for (; offset + filter_word_size <= count; offset += filter_word_size) {
+    uint64_t mask;
+#if defined(__AVX2__)
+    if constexpr (is_avx2_filter_type<T>::value) {
+      mask = match_avx2<Op, Swap>(input + offset * sizeof(T), low, high);
+    } else
+#endif
+    {
+      mask = match_scalar<Op>(input + offset * sizeof(T), filter_word_size,
+                              is_big_endian, low, high);
+    }
+    on_word(word++, mask);
+  }
+  if (offset < count) {
+    on_word(word, match_scalar<Op>(input + offset * sizeof(T), count - offset,
+                                   is_big_endian, low, high));
+  }
+}
+
+/**
+ * @brief Call `on_word(index, mask)` for each word of 64 results, choosing
+ * the comparison and the byte order once for the whole array.
+ */
+template <typename T, typename F>
+inline void for_each_match_word(const uint8_t *input, size_t count,
+                                bool is_big_endian, const predicate<T> &where,
+                                F &&on_word) {
+  bool swap = needs_byte_swap(is_big_endian);
+  auto run = [&](auto op) {
+    constexpr comparison Op = decltype(op)::value;
+    if (swap) {
+      match_words<Op, true>(input, count, is_big_endian, where.value,
+                            where.upper, on_word);
+    } else {
+      match_words<Op, false>(input, count, is_big_endian, where.value,
+                             where.upper, on_word);
+    }
+  };
+  using std::integral_constant;
+  switch (where.op) {
+  case comparison::less:
+    run(integral_constant<comparison, comparison::less>());
+    break;
+  case comparison::less_equal:
+    run(integral_constant<comparison, comparison::less_equal>());
+    break;
+  case comparison::equal:
+    run(integral_constant<comparison, comparison::equal>());
+    break;
+  case comparison::greater:
+    run(integral_constant<comparison, comparison::greater>());
+    break;
+  case comparison::greater_equal:
+    run(integral_constant<comparison, comparison::greater_equal>());
+    break;
+  case comparison::between:
+    run(integral_constant<comparison, comparison::between>());
+    break;
+  }
+}
+
+}; // namespace detail
+
+/**
+ * @brief Evaluate `where` on `count` encoded values and write one bit per
+ * value to `bitmap`, least significant bit first, as `bits_to_bytes` does.
+ * Writes `(count + 7) / 8` bytes and returns the number of matches.
+ */
+template <typename T>
+inline size_t filter_to_bitmap(const uint8_t *input, size_t count,
+                               bool is_big_endian, const predicate<T> &where,
+                               uint8_t *bitmap) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "filter_to_bitmap needs an integer or floating-point type");
+  size_t matches = 0;
+  auto on_word = [&](size_t word, uint64_t mask) {
+    size_t bytes = std::min<size_t>(8, (count - word * 64 + 7) / 8);
+    uint8_t *target = bitmap + word * 8;
+    if (bytes == 8) {
+      detail::store_u64_le(target, mask);
+    } else {
+      for (size_t i = 0; i < bytes; i++) {
+        target[i] = static_cast<uint8_t>(mask >> (i * 8));
+      }
+    }
+    matches += static_cast<size_t>(detail::popcount(mask));
+  };
+  detail::for_each_match_word(input, count, is_big_endian, where, on_word);
+  return matches;
+}
+
+/**
+ * @brief Evaluate `where` on `count` encoded values and write the positions
+ * of the matching values to `indices`, which needs room for `count` entries.
+ * Returns the number of matches. `Index` must hold every position below
+ * `count`, so `uint32_t` indices limit the input to 2^32 values.
+ */
+template <typename T, typename Index>
+inline size_t filter_to_indices(const uint8_t *input, size_t count,
+                                bool is_big_endian, const predicate<T> &where,
+                                Index *indices) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "filter_to_indices needs an integer or floating-point type");
+  static_assert(std::is_unsigned<Index>::value &&
+                    !std::is_same<Index, bool>::value,
+                "filter_to_indices needs unsigned integer indices");
+  assert(count == 0 || count - 1 <= std::numeric_limits<Index>::max());
+  size_t matches = 0;
+  auto on_word = [&](size_t word, uint64_t mask) {
+    size_t base = word * 64;
+    while (mask != 0) {
+      indices[matches++] = static_cast<Index>(
+          base + static_cast<size_t>(detail::count_trailing_zeros(mask)));
+      mask &= mask - 1;
+    }
+  };
+  detail::for_each_match_word(input, count, is_big_endian, where, on_word);
+  return matches;
+}
+
+}; // namespace bit_converter
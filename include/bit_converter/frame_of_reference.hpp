@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "bit_converter.hpp"
+#include "detail.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace bit_converter {
+
+/**
+ * @brief The number of values in a frame-of-reference block. Only the last
+ * block of a sequence may be shorter.
+ */
+constexpr size_t frame_of_reference_block_size = 128;
+
+/**
+ * @brief The size of a block header: the block minimum written with
+ * `i64_to_bytes` followed by one byte holding the bit width of the residuals.
+ */
+constexpr size_t frame_of_reference_header_size = sizeof(int64_t) + 1;
+
+namespace detail {
+
+// Room for a full block at 64 bits per value plus slack for 8-byte loads.
+constexpr size_t frame_of_reference_buffer_size =
+    frame_of_reference_block_size * sizeof(uint64_t) + 16;
+
+inline int bit_width(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+#else
+  int width = 0;
+  while (value != 0) {
+    value = value >> 1;
+    width++;
+  }
+  return width;
+#endif
+}
+
+inline size_t packed_size(size_t count, int width) {
+  return (count * static_cast<size_t>(width) + 7) / 8;
+}
+
+/**
+ * @brief Pack the low `width` bits of every residual into a little-endian bit
+ * stream. `output` needs eight bytes of slack after the packed size.
+ */
+inline void pack_residuals(const uint64_t *residuals, size_t count, int width,
+                           uint8_t *output) {
+  if (width == 0) {
+    return;
+  }
+  uint64_t buffer = 0;
+  int filled = 0;
+  for (size_t i = 0; i < count; i++) {
+    buffer = buffer | (residuals[i] << filled);
+    filled = filled + width;
+    if (filled >= 64) {
+      store_u64_le(output, buffer);
+      output = output + 8;
+      filled = filled - 64;
+      buffer = filled == 0 ? 0 : residuals[i] >> (width - filled);
+    }
+  }
+  if (filled > 0) {
+    store_u64_le(output, buffer);
+  }
+}
+
+/**
+ * @brief Extract `count` residuals of `width` bits each and add `base` to
+ * them. `input` needs eight bytes of slack after the packed size.
+ */
+template <typename T>
+inline void unpack_residuals(const uint8_t *input, size_t count, int width,
+                             uint64_t base, T *values) {
+  size_t i = 0;
+  if (width == 0) {
+    std::fill(values, values + count, static_cast<T>(base));
+    return;
+  }
+#if defined(__AVX2__)
+  if (width <= 25) {
+    // Eight values span exactly `width` bytes, so every group of eight uses
+    // the same byte offsets and shifts; each value fits in one 32-bit load.
+    alignas(32) int32_t offsets[8];
+    alignas(32) int32_t shifts[8];
+    for (int k = 0; k < 8; k++) {
+      offsets[k] = k * width / 8;
+      shifts[k] = k * width % 8;
+    }
+    const __m256i offset_vector =
+        _mm256_load_si256(reinterpret_cast<const __m256i *>(offsets));
+    const __m256i shift_vector =
+        _mm256_load_si256(reinterpret_cast<const __m256i *>(shifts));
+    const __m256i mask =
+        _mm256_set1_epi32(static_cast<int32_t>((1U << width) - 1));
+    for (; i + 8 <= count; i += 8) {
+      const uint8_t *group = input + i / 8 * static_cast<size_t>(width);
+      __m256i x = _mm256_i32gather_epi32(
+          reinterpret_cast<const int *>(group), offset_vector, 1);
+      x = _mm256_and_si256(_mm256_srlv_epi32(x, shift_vector), mask);
+      if constexpr (sizeof(T) == 4) {
+        x = _mm256_add_epi32(x, _mm256_set1_epi32(static_cast<int32_t>(base)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + i), x);
+      } else if constexpr (sizeof(T) == 8) {
+        const __m256i base_vector =
+            _mm256_set1_epi64x(static_cast<int64_t>(base));
+        __m256i low = _mm256_add_epi64(
+            _mm256_cvtepu32_epi64(_mm256_castsi256_si128(x)), base_vector);
+        __m256i high = _mm256_add_epi64(
+            _mm256_cvtepu32_epi64(_mm256_extracti128_si256(x, 1)),
+            base_vector);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + i), low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + i + 4), high);
+      } else {
+        break;
+      }
+    }
+  }
+#endif
+  const uint64_t mask = width == 64 ? ~0ULL : ((1ULL << width) - 1);
+  for (; i < count; i++) {
+    size_t bit = i * static_cast<size_t>(width);
+    const uint8_t *p = input + bit / 8;
+    int shift = static_cast<int>(bit % 8);
+    uint64_t residual = load_u64_le(p) >> shift;
+    if (shift + width > 64) {
+      residual = residual | (static_cast<uint64_t>(p[8]) << (64 - shift));
+    }
+    values[i] = static_cast<T>(base + (residual & mask));
+  }
+}
+
+}; // namespace detail
+
+/**
+ * @brief Returns the largest number of bytes `frame_of_reference_to_bytes`
+ * can write for `count` values of type `T`.
+ */
+template <typename T> inline size_t frame_of_reference_max_size(size_t count) {
+  size_t blocks = (count + frame_of_reference_block_size - 1) /
+                  frame_of_reference_block_size;
+  return blocks * frame_of_reference_header_size + count * sizeof(T);
+}
+
+/**
+ * @brief Encode integers in blocks of `frame_of_reference_block_size` values.
+ * Each block stores its minimum with `i64_to_bytes` and the bit width of the
+ * largest residual, followed by every value minus the minimum bit-packed at
+ * that width, least significant bit first.
+ */
+template <typename T, typename OutputIt>
+inline OutputIt frame_of_reference_to_bytes(const T *values, size_t count,
+                                            bool is_big_endian,
+                                            OutputIt output_it) {
+  static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(int64_t),
+                "frame-of-reference encoding needs an integer type");
+  uint64_t residuals[frame_of_reference_block_size];
+  uint8_t packed[detail::frame_of_reference_buffer_size];
+  for (size_t offset = 0; offset < count;
+       offset += frame_of_reference_block_size) {
+    size_t n = std::min(count - offset, frame_of_reference_block_size);
+    const T *block = values + offset;
+    auto bounds = std::minmax_element(block, block + n);
+    uint64_t base = static_cast<uint64_t>(*bounds.first);
+    int width =
+        detail::bit_width(static_cast<uint64_t>(*bounds.second) - base);
+    for (size_t i = 0; i < n; i++) {
+      residuals[i] = static_cast<uint64_t>(block[i]) - base;
+    }
+    detail::pack_residuals(residuals, n, width, packed);
+
+    output_it =
+        i64_to_bytes(static_cast<int64_t>(base), is_big_endian, output_it);
+    *output_it = static_cast<uint8_t>(width);
+    output_it++;
+    output_it =
+        std::copy(packed, packed + detail::packed_size(n, width), output_it);
+  }
+  return output_it;
+}
+
+/**
+ * @brief Decode `count` integers written by `frame_of_reference_to_bytes`.
+ * Returns the position after the last block.
+ */
+template <typename T, typename InputIt>
+inline InputIt bytes_to_frame_of_reference(InputIt input_it, size_t count,
+                                           bool is_big_endian, T *values) {
+  static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(int64_t),
+                "frame-of-reference encoding needs an integer type");
+  uint8_t packed[detail::frame_of_reference_buffer_size];
+  for (size_t offset = 0; offset < count;
+       offset += frame_of_reference_block_size) {
+    size_t n = std::min(count - offset, frame_of_reference_block_size);
+    uint8_t header[frame_of_reference_header_size];
+    for (size_t k = 0; k < frame_of_reference_header_size; k++) {
+      header[k] = static_cast<uint8_t>(*input_it);
+      input_it++;
+    }
+    uint64_t base = static_cast<uint64_t>(bytes_to_i64(header, is_big_endian));
+    int width = std::min<int>(header[sizeof(int64_t)], 64);
+    size_t size = detail::packed_size(n, width);
+    if constexpr (detail::is_byte_pointer<InputIt>::value) {
+      const uint8_t *block = reinterpret_cast<const uint8_t *>(&*input_it);
+      input_it += size;
+      if (offset + n < count) {
+        // The next block header provides the slack the unpacking loads need.
+        detail::unpack_residuals(block, n, width, base, values + offset);
+        continue;
+      }
+      std::memcpy(packed, block, size);
+    } else {
+      for (size_t k = 0; k < size; k++) {
+        packed[k] = static_cast<uint8_t>(*input_it);
+        input_it++;
+      }
+    }
+    std::memset(packed + size, 0, 16);
+    detail::unpack_residuals(packed, n, width, base, values + offset);
+  }
+  return input_it;
+}
+
+}; // namespace bit_converter
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+namespace detail {
+
+/**
+ * @brief How many positions ahead of the current one are prefetched. Random
+ * reads from a buffer larger than the last-level cache are bound by memory
+ * latency, so the loads have to be started well before they are used; much
+ * further ahead, the prefetched lines are evicted before they are read.
+ */
+constexpr size_t gather_prefetch_distance = 16;
+
+inline void prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#elif defined(_MSC_VER)
+  _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+  static_cast<void>(address);
+#endif
+}
+
+template <typename Index>
+using is_gather_index =
+    std::integral_constant<bool, std::is_integral<Index>::value &&
+                                     std::is_unsigned<Index>::value &&
+                                     !std::is_same<Index, bool>::value>;
+
+template <typename T, size_t Stride, typename Index>
+inline void gather(const uint8_t *base, const Index *indices, size_t count,
+                   bool is_big_endian, T *values) {
+  using U = uint_of_size<T>;
+  bool swap = needs_byte_swap(is_big_endian);
+  size_t i = 0;
+  for (; i + gather_prefetch_distance < count; i++) {
+    prefetch(base + indices[i + gather_prefetch_distance] * Stride);
+    U raw = load_unaligned<U>(base + indices[i] * Stride);
+    values[i] = bit_cast<T>(swap ? byte_swap(raw) : raw);
+  }
+  for (; i < count; i++) {
+    U raw = load_unaligned<U>(base + indices[i] * Stride);
+    values[i] = bit_cast<T>(swap ? byte_swap(raw) : raw);
+  }
+}
+
+}; // namespace detail
+
+/**
+ * @brief Decode the values at positions `indices[0..count)` of an encoded
+ * array, i.e. at `base + indices[i] * sizeof(T)`, into `values`. The reads
+ * are prefetched ahead, so random accesses into a large buffer overlap their
+ * cache misses.
+ */
+template <typename T, typename Index>
+inline void gather_values(const uint8_t *base, const Index *indices,
+                          size_t count, bool is_big_endian, T *values) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "gather_values needs an integer or floating-point type");
+  static_assert(detail::is_gather_index<Index>::value,
+                "gather_values needs unsigned integer indices");
+  detail::gather<T, sizeof(T)>(base, indices, count, is_big_endian, values);
+}
+
+/**
+ * @brief Decode the values starting at the byte offsets
+ * `base + offsets[i]`, which need not be aligned to the value size, as
+ * `gather_values` does.
+ */
+template <typename T, typename Offset>
+inline void gather_at_offsets(const uint8_t *base, const Offset *offsets,
+                              size_t count, bool is_big_endian, T *values) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "gather_at_offsets needs an integer or floating-point type");
+  static_assert(detail::is_gather_index<Offset>::value,
+                "gather_at_offsets needs unsigned integer offsets");
+  detail::gather<T, 1>(base, offsets, count, is_big_endian, values);
+}
+
+}; // namespace bit_converter
@@ -0,0 +1,195 @@
+#pragma once
+
+// Coroutine streams need C++20; in C++17 builds this header is empty.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#include <algorithm>
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bulk.hpp"
+#include "file_source.hpp"
+#include "stream.hpp"
+
+namespace bit_converter {
+
+/**
+ * @brief The number of bytes decoded per batch by the coroutine streams,
+ * small enough for the batch to stay in the L1 cache.
+ */
+constexpr size_t generator_batch_bytes = 16 << 10;
+
+/**
+ * @brief A lazily decoded sequence of values produced by a coroutine. The
+ * coroutine decodes a whole batch with the bulk converters and yields it once,
+ * and the iterator walks the batch, so the coroutine is resumed once per batch
+ * instead of once per value.
+ *
+ * The stream can be iterated only once. `error` returns 0 or an `errno` value
+ * after the iteration has ended.
+ */
+template <typename T> class value_stream {
+public:
+  struct batch {
+    const T *values;
+    size_t count;
+  };
+
+  struct promise_type {
+    batch current = {nullptr, 0};
+    int failure = 0;
+
+    value_stream get_return_object() {
+      return value_stream(handle::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    std::suspend_always yield_value(batch next) noexcept {
+      current = next;
+      return {};
+    }
+    void return_value(int error) noexcept { failure = error; }
+    void unhandled_exception() { throw; }
+  };
+
+  using handle = std::coroutine_handle<promise_type>;
+
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    iterator() = default;
+    explicit iterator(handle coroutine) : coroutine(coroutine) { next_batch(); }
+
+    const T &operator*() const { return *position; }
+
+    iterator &operator++() {
+      if (++position == last) {
+        next_batch();
+      }
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator &it, std::default_sentinel_t) {
+      return it.position == nullptr;
+    }
+
+  private:
+    void next_batch() {
+      do {
+        coroutine.resume();
+        if (coroutine.done()) {
+          position = last = nullptr;
+          return;
+        }
+        position = coroutine.promise().current.values;
+        last = position + coroutine.promise().current.count;
+      } while (position == last);
+    }
+
+    handle coroutine = nullptr;
+    const T *position = nullptr;
+    const T *last = nullptr;
+  };
+
+  value_stream(value_stream &&other) noexcept
+      : coroutine(std::exchange(other.coroutine, nullptr)) {}
+
+  value_stream &operator=(value_stream &&other) noexcept {
+    std::swap(coroutine, other.coroutine);
+    return *this;
+  }
+
+  ~value_stream() {
+    if (coroutine) {
+      coroutine.destroy();
+    }
+  }
+
+  // A moved-from stream is empty and reports no error.
+  iterator begin() { return coroutine ? iterator(coroutine) : iterator(); }
+  std::default_sentinel_t end() { return {}; }
+
+  int error() const { return coroutine ? coroutine.promise().failure : 0; }
+
+private:
+  explicit value_stream(handle coroutine) : coroutine(coroutine) {}
+
+  handle coroutine;
+};
+
+/**
+ * @brief Lazily decode the values stored in `size` bytes at `data`, which
+ * must stay alive while the stream is iterated. A trailing partial value is
+ * reported as `EINVAL`.
+ */
+template <typename T>
+inline value_stream<T> decode_stream(const uint8_t *data, size_t size,
+                                     bool is_big_endian) {
+  std::vector<T> batch(generator_batch_bytes / sizeof(T));
+  size_t count = size / sizeof(T);
+  for (size_t offset = 0; offset < count; offset += batch.size()) {
+    size_t n = std::min(count - offset, batch.size());
+    bytes_to_values(data + offset * sizeof(T), n, is_big_endian, batch.data());
+    co_yield {batch.data(), n};
+  }
+  co_return size % sizeof(T) == 0 ? 0 : EINVAL;
+}
+
+/**
+ * @brief Lazily decode the bytes returned by `read(buffer, capacity)`, which
+ * returns the number of bytes it stored and 0 at the end of the input. Values
+ * may be split across reads.
+ */
+template <typename T, typename Read>
+inline value_stream<T> decode_stream(Read read, bool is_big_endian) {
+  std::vector<uint8_t> block(generator_batch_bytes);
+  std::vector<T> batch(generator_batch_bytes / sizeof(T) + 1);
+  stream_decoder<T> decoder(is_big_endian);
+  size_t size;
+  while ((size = read(block.data(), block.size())) > 0) {
+    decoder.feed(block.data(), size);
+    while (!decoder.is_drained()) {
+      size_t n = decoder.read(batch.data(), batch.size());
+      if (n > 0) {
+        co_yield {batch.data(), n};
+      }
+    }
+  }
+  co_return decoder.carried_bytes() == 0 ? 0 : EINVAL;
+}
+
+/**
+ * @brief Lazily decode the values of the file at `path` with a
+ * `file_decoder`, which keeps the next blocks of the file in flight.
+ */
+template <typename T>
+inline value_stream<T>
+decode_file_stream(std::string path, bool is_big_endian,
+                   file_source::options config = file_source::options()) {
+  file_decoder<T> decoder(path.c_str(), is_big_endian, config);
+  const T *values;
+  size_t count;
+  while (decoder.next_batch(values, count)) {
+    co_yield {values, count};
+  }
+  co_return decoder.error();
+}
+
+}; // namespace bit_converter
+
+#endif
+#endif
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "bit_converter.hpp"
+#include "detail.hpp"
+
+namespace bit_converter {
+
+namespace detail {
+
+/**
+ * @brief Load eight bytes as a big-endian word.
+ */
+inline uint64_t load_u64_be(const uint8_t *source) {
+  uint64_t value = load_unaligned<uint64_t>(source);
+  return is_little_endian_host ? byte_swap(value) : value;
+}
+
+/**
+ * @brief Writes bits most significant first, emitting every completed byte.
+ */
+template <typename OutputIt> class bit_writer {
+public:
+  explicit bit_writer(OutputIt output_it) : output_it(output_it) {}
+
+  /**
+   * @brief Append the low `count` bits of `value`, where `count` <= 32.
+   */
+  void write(uint64_t value, int count) {
+    buffer = (buffer << count) | value;
+    filled = filled + count;
+    while (filled >= 8) {
+      filled = filled - 8;
+      *output_it = static_cast<uint8_t>(buffer >> filled);
+      output_it++;
+    }
+  }
+
+  void write_u64(uint64_t value, int count) {
+    if (count > 32) {
+      write(value >> 32, count - 32);
+      write(value & 0xFFFFFFFFULL, 32);
+    } else {
+      write(value, count);
+    }
+  }
+
+  /**
+   * @brief Pad the last byte with zero bits and return the output position.
+   */
+  OutputIt flush() {
+    if (filled > 0) {
+      *output_it = static_cast<uint8_t>(buffer << (8 - filled));
+      output_it++;
+      filled = 0;
+    }
+    buffer = 0;
+    return output_it;
+  }
+
+private:
+  OutputIt output_it;
+  uint64_t buffer = 0;
+  int filled = 0;
+};
+
+/**
+ * @brief Returns the 64 bits that start at bit `position` of the stream, most
+ * significant first, padded with zeros past the end.
+ */
+inline uint64_t peek_bits(const uint8_t *data, size_t size, size_t position) {
+  size_t offset = position / 8;
+  int shift = static_cast<int>(position % 8);
+  if (offset + 9 <= size) {
+    const uint8_t *p = data + offset;
+    return (load_u64_be(p) << shift) |
+           (static_cast<uint64_t>(p[8]) >> (8 - shift));
+  }
+  uint8_t tail[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+  if (offset < size) {
+    std::memcpy(tail, data + offset, size - offset);
+  }
+  return (load_u64_be(tail) << shift) |
+         (static_cast<uint64_t>(tail[8]) >> (8 - shift));
+}
+
+}; // namespace detail
+
+/**
+ * @brief A streaming encoder of double-precision values using the XOR scheme
+ * of Facebook's Gorilla time-series database. The first value is stored in
+ * 64 bits. Every later value is XORed with its predecessor and stored as:
+ *
+ * - `0` when it repeats the previous value;
+ * - `10` and the meaningful bits when they fit in the previous window;
+ * - `11`, five bits of leading zeros, six bits of meaningful length (0 means
+ *   64) and the meaningful bits otherwise.
+ *
+ * The stream carries no value count, so the reader must know it.
+ */
+template <typename OutputIt> class gorilla_encoder {
+public:
+  explicit gorilla_encoder(OutputIt output_it) : writer(output_it) {}
+
+  void append(double_t value) {
+    uint64_t bits = detail::bit_cast<uint64_t>(static_cast<double>(value));
+    if (is_first) {
+      writer.write_u64(bits, 64);
+      is_first = false;
+    } else {
+      uint64_t x = bits ^ previous;
+      if (x == 0) {
+        writer.write(0, 1);
+      } else {
+        int leading = detail::count_leading_zeros(x);
+        int trailing = detail::count_trailing_zeros(x);
+        leading = leading > 31 ? 31 : leading;
+        if (has_window && leading >= window_leading &&
+            trailing >= 64 - window_leading - window_length) {
+          writer.write(2, 2);
+          writer.write_u64(x >> (64 - window_leading - window_length),
+                           window_length);
+        } else {
+          int length = 64 - leading - trailing;
+          writer.write(3, 2);
+          writer.write(static_cast<uint64_t>(leading), 5);
+          writer.write(static_cast<uint64_t>(length & 63), 6);
+          writer.write_u64(x >> trailing, length);
+          window_leading = leading;
+          window_length = length;
+          has_window = true;
+        }
+      }
+    }
+    previous = bits;
+  }
+
+  /**
+   * @brief Pad the final byte and return the position after the stream.
+   */
+  OutputIt finish() { return writer.flush(); }
+
+private:
+  detail::bit_writer<OutputIt> writer;
+  uint64_t previous = 0;
+  int window_leading = 0;
+  int window_length = 0;
+  bool has_window = false;
+  bool is_first = true;
+};
+
+/**
+ * @brief Decodes a stream written by `gorilla_encoder`. The control bits are
+ * resolved with selects rather than branches so that irregular series do not
+ * cost branch mispredictions.
+ */
+class gorilla_decoder {
+public:
+  gorilla_decoder(const uint8_t *data, size_t size) : data(data), size(size) {}
+
+  double_t next() {
+    if (position == 0) {
+      previous = detail::peek_bits(data, size, 0);
+      position = 64;
+      return detail::bit_cast<double>(previous);
+    }
+    // Two control bits, five bits of leading zeros and six bits of length.
+    uint64_t control = detail::peek_bits(data, size, position) >> 51;
+    bool is_nonzero = (control >> 12) != 0;
+    bool is_new_window = (control >> 11) == 3;
+    int new_length = static_cast<int>(control & 63);
+    window_leading =
+        is_new_window ? static_cast<int>((control >> 6) & 31) : window_leading;
+    window_length = is_new_window ? (new_length == 0 ? 64 : new_length)
+                                  : window_length;
+    position += is_nonzero ? (is_new_window ? 13 : 2) : 1;
+
+    int length = is_nonzero ? window_length : 0;
+    uint64_t meaningful = detail::peek_bits(data, size, position);
+    meaningful = length == 0 ? 0 : meaningful >> (64 - length);
+    position += static_cast<size_t>(length);
+    previous = previous ^ (length == 0 ? 0
+                                       : meaningful << (64 - window_leading -
+                                                        length));
+    return detail::bit_cast<double>(previous);
+  }
+
+  /**
+   * @brief Returns the number of bytes consumed so far, including the padding
+   * of a partial final byte.
+   */
+  size_t consumed() const { return (position + 7) / 8; }
+
+private:
+  const uint8_t *data;
+  size_t size;
+  size_t position = 0;
+  uint64_t previous = 0;
+  int window_leading = 0;
+  int window_length = 0;
+};
+
+/**
+ * @brief Encode the values with `gorilla_encoder`.
+ */
+template <typename OutputIt>
+inline OutputIt f64_to_gorilla(const double *values, size_t count,
+                               OutputIt output_it) {
+  gorilla_encoder<OutputIt> encoder(output_it);
+  for (size_t i = 0; i < count; i++) {
+    encoder.append(values[i]);
+  }
+  return encoder.finish();
+}
+
+/**
+ * @brief Decode `count` values written by `f64_to_gorilla` from `size` bytes.
+ * Returns the number of bytes consumed.
+ */
+inline size_t gorilla_to_f64(const uint8_t *data, size_t size, size_t count,
+                             double *values) {
+  gorilla_decoder decoder(data, size);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = decoder.next();
+  }
+  return decoder.consumed();
+}
+
+}; // namespace bit_converter
@@ -0,0 +1,425 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace bit_converter {
+
+namespace detail {
+
+/**
+ * @brief The two digits of every byte in both cases, and the value of every
+ * character that is a hex digit, with 0xFF for the others.
+ */
+struct hex_tables {
+  char upper[256][2];
+  char lower[256][2];
+  uint8_t nibble[256];
+
+  constexpr hex_tables() : upper(), lower(), nibble() {
+    const char *upper_digits = "0123456789ABCDEF";
+    const char *lower_digits = "0123456789abcdef";
+    for (int i = 0; i < 256; i++) {
+      upper[i][0] = upper_digits[i >> 4];
+      upper[i][1] = upper_digits[i & 0xF];
+      lower[i][0] = lower_digits[i >> 4];
+      lower[i][1] = lower_digits[i & 0xF];
+      nibble[i] = 0xFF;
+    }
+    for (int i = 0; i < 16; i++) {
+      nibble[static_cast<uint8_t>(upper_digits[i])] = static_cast<uint8_t>(i);
+      nibble[static_cast<uint8_t>(lower_digits[i])] = static_cast<uint8_t>(i);
+    }
+  }
+};
+
+inline const hex_tables &hex_lookup() {
+  static constexpr hex_tables tables;
+  return tables;
+}
+
+inline char *bytes_to_hex_scalar(const uint8_t *data, size_t size,
+                                 char *output, char separator,
+                                 bool is_upper_case) {
+  const auto &pairs =
+      is_upper_case ? hex_lookup().upper : hex_lookup().lower;
+  for (size_t i = 0; i < size; i++) {
+    if (separator != '\0' && i != 0) {
+      *output++ = separator;
+    }
+    output[0] = pairs[data[i]][0];
+    output[1] = pairs[data[i]][1];
+    output += 2;
+  }
+  return output;
+}
+
+inline bool hex_to_bytes_scalar(const char *input, size_t count,
+                                uint8_t *output, char separator) {
+  const uint8_t *nibble = hex_lookup().nibble;
+  const size_t stride = separator != '\0' ? 3 : 2;
+  for (size_t i = 0; i < count; i++, input += stride) {
+    if (separator != '\0' && i != 0 && input[-1] != separator) {
+      return false;
+    }
+    uint8_t high = nibble[static_cast<uint8_t>(input[0])];
+    uint8_t low = nibble[static_cast<uint8_t>(input[1])];
+    if ((high | low) & 0xF0) {
+      return false;
+    }
+    output[i] = static_cast<uint8_t>(high << 4 | low);
+  }
+  return true;
+}
+
+#if defined(__SSSE3__)
+
+/**
+ * @brief The digits of the high and low nibbles of each byte, looked up 16
+ * at a time with `pshufb`, interleaved into the 32 characters of 16 bytes.
+ */
+inline void hex_digits_16(__m128i bytes, __m128i digits, __m128i &first,
+                          __m128i &second) {
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  __m128i high =
+      _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+  __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, mask));
+  first = _mm_unpacklo_epi8(high, low);
+  second = _mm_unpackhi_epi8(high, low);
+}
+
+/**
+ * @brief The values of 16 characters, with `valid` set to all ones for the
+ * ones that are hex digits. Setting bit 5 maps 'A'-'F' to 'a'-'f' and leaves
+ * digits alone, so one range check covers both cases.
+ */
+inline __m128i hex_nibbles_16(__m128i chars, __m128i &valid) {
+  __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  __m128i is_digit =
+      _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+  __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)),
+                                _mm_set1_epi8('a'));
+  __m128i is_letter =
+      _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+  valid = _mm_or_si128(is_digit, is_letter);
+  return _mm_or_si128(
+      _mm_and_si128(is_digit, digit),
+      _mm_andnot_si128(is_digit, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+/**
+ * @brief Join pairs of nibbles, high first, into bytes.
+ */
+inline __m128i hex_join_16(__m128i nibbles) {
+  return _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+}
+
+inline __m128i hex_separator_mask(__m128i indices, char separator) {
+  return _mm_and_si128(_mm_cmpeq_epi8(indices, _mm_set1_epi8(-128)),
+                       _mm_set1_epi8(separator));
+}
+
+/**
+ * @brief Encode 16 bytes into 48 characters at a time: each group of 16
+ * output characters takes its digits from a window of the 32 with one
+ * `pshufb`, leaving zeros where the separators go.
+ */
+inline size_t bytes_to_hex_separated_simd(const uint8_t *data, size_t size,
+                                          char *output, char separator,
+                                          __m128i digits) {
+  const __m128i first_indices = _mm_setr_epi8(0, 1, -128, 2, 3, -128, 4, 5,
+                                              -128, 6, 7, -128, 8, 9, -128, 10);
+  const __m128i second_indices =
+      _mm_setr_epi8(3, -128, 4, 5, -128, 6, 7, -128, 8, 9, -128, 10, 11, -128,
+                    12, 13);
+  const __m128i third_indices =
+      _mm_setr_epi8(-128, 6, 7, -128, 8, 9, -128, 10, 11, -128, 12, 13, -128,
+                    14, 15, -128);
+  const __m128i first_separators =
+      hex_separator_mask(first_indices, separator);
+  const __m128i second_separators =
+      hex_separator_mask(second_indices, separator);
+  const __m128i third_separators =
+      hex_separator_mask(third_indices, separator);
+  size_t i = 0;
+  // The last group of 48 ends in a separator, so a byte must follow it.
+  for (; i + 16 < size; i += 16, output += 48) {
+    __m128i first, second;
+    hex_digits_16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)), digits,
+        first, second);
+    __m128i middle = _mm_alignr_epi8(second, first, 8);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(output),
+        _mm_or_si128(_mm_shuffle_epi8(first, first_indices), first_separators));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16),
+                     _mm_or_si128(_mm_shuffle_epi8(middle, second_indices),
+                                  second_separators));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 32),
+                     _mm_or_si128(_mm_shuffle_epi8(second, third_indices),
+                                  third_separators));
+  }
+  return i;
+}
+
+/**
+ * @brief Decode 48 characters into 16 bytes at a time. The digit and
+ * separator checks of each character are gathered into 48-bit masks, and
+ * the digits of each byte are moved next to each other with `pshufb`.
+ */
+inline size_t hex_to_bytes_separated_simd(const char *input, size_t count,
+                                          uint8_t *output, char separator,
+                                          bool &valid) {
+  constexpr uint64_t digit_positions = 0x6DB6DB6DB6DB;
+  constexpr uint64_t separator_positions = 0x924924924924;
+  const __m128i first_low = _mm_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 12, 13, 15,
+                                          -128, -128, -128, -128, -128);
+  const __m128i first_high =
+      _mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+                    -128, 0, 2, 3, 5, 6);
+  const __m128i second_low =
+      _mm_setr_epi8(8, 9, 11, 12, 14, 15, -128, -128, -128, -128, -128, -128,
+                    -128, -128, -128, -128);
+  const __m128i second_high =
+      _mm_setr_epi8(-128, -128, -128, -128, -128, -128, 1, 2, 4, 5, 7, 8, 10,
+                    11, 13, 14);
+  const __m128i separators = _mm_set1_epi8(separator);
+  size_t i = 0;
+  for (; i + 16 < count; i += 16, input += 48) {
+    __m128i chars[3], nibbles[3];
+    uint64_t digits = 0;
+    uint64_t separated = 0;
+    for (int j = 0; j < 3; j++) {
+      __m128i is_digit;
+      chars[j] =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16 * j));
+      nibbles[j] = hex_nibbles_16(chars[j], is_digit);
+      digits |= static_cast<uint64_t>(_mm_movemask_epi8(is_digit)) << (16 * j);
+      separated |= static_cast<uint64_t>(_mm_movemask_epi8(
+                       _mm_cmpeq_epi8(chars[j], separators)))
+                   << (16 * j);
+    }
+    if ((digits & digit_positions) != digit_positions ||
+        (separated & separator_positions) != separator_positions) {
+      valid = false;
+      return i;
+    }
+    __m128i first = _mm_or_si128(_mm_shuffle_epi8(nibbles[0], first_low),
+                                 _mm_shuffle_epi8(nibbles[1], first_high));
+    __m128i second = _mm_or_si128(_mm_shuffle_epi8(nibbles[1], second_low),
+                                  _mm_shuffle_epi8(nibbles[2], second_high));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(output + i),
+        _mm_packus_epi16(hex_join_16(first), hex_join_16(second)));
+  }
+  return i;
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+/**
+ * @brief Encode 32 bytes into 64 characters at a time. The quarters of the
+ * input are reordered first so that the in-lane unpacks leave the
+ * characters in order.
+ */
+inline size_t bytes_to_hex_simd(const uint8_t *data, size_t size,
+                                char *output, __m128i digits) {
+  const __m256i table = _mm256_broadcastsi128_si256(digits);
+  const __m256i mask = _mm256_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32, output += 64) {
+    __m256i bytes = _mm256_permute4x64_epi64(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), 0xD8);
+    __m256i high = _mm256_shuffle_epi8(
+        table, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+    __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(bytes, mask));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output),
+                        _mm256_unpacklo_epi8(high, low));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + 32),
+                        _mm256_unpackhi_epi8(high, low));
+  }
+  return i;
+}
+
+inline __m256i hex_nibbles_32(__m256i chars, __m256i &valid) {
+  __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+  __m256i is_digit =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+  __m256i letter = _mm256_sub_epi8(
+      _mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  __m256i is_letter =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+  valid = _mm256_or_si256(is_digit, is_letter);
+  return _mm256_blendv_epi8(_mm256_add_epi8(letter, _mm256_set1_epi8(10)),
+                            digit, is_digit);
+}
+
+/**
+ * @brief Decode 64 characters into 32 bytes at a time.
+ */
+inline size_t hex_to_bytes_simd(const char *input, size_t count,
+                                uint8_t *output, bool &valid) {
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32, input += 64) {
+    __m256i first_valid, second_valid;
+    __m256i first = hex_nibbles_32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input)),
+        first_valid);
+    __m256i second = hex_nibbles_32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + 32)),
+        second_valid);
+    if (_mm256_movemask_epi8(_mm256_and_si256(first_valid, second_valid)) !=
+        -1) {
+      valid = false;
+      return i;
+    }
+    __m256i bytes =
+        _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights),
+                            _mm256_maddubs_epi16(second, weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i),
+                        _mm256_permute4x64_epi64(bytes, 0xD8));
+  }
+  return i;
+}
+
+#elif defined(__SSSE3__)
+
+inline size_t bytes_to_hex_simd(const uint8_t *data, size_t size,
+                                char *output, __m128i digits) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16, output += 32) {
+    __m128i first, second;
+    hex_digits_16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)), digits,
+        first, second);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output), first);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16), second);
+  }
+  return i;
+}
+
+inline size_t hex_to_bytes_simd(const char *input, size_t count,
+                                uint8_t *output, bool &valid) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16, input += 32) {
+    __m128i first_valid, second_valid;
+    __m128i first = hex_nibbles_16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(input)),
+        first_valid);
+    __m128i second = hex_nibbles_16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16)),
+        second_valid);
+    if (_mm_movemask_epi8(_mm_and_si128(first_valid, second_valid)) !=
+        0xFFFF) {
+      valid = false;
+      return i;
+    }
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(output + i),
+        _mm_packus_epi16(hex_join_16(first), hex_join_16(second)));
+  }
+  return i;
+}
+
+#endif
+
+}; // namespace detail
+
+/**
+ * @brief Returns the number of characters `bytes_to_hex` writes for `size`
+ * bytes: two digits per byte, with a separator between bytes unless
+ * `separator` is '\0'.
+ */
+inline size_t hex_size(size_t size, char separator = '\0') {
+  if (size == 0) {
+    return 0;
+  }
+  return separator != '\0' ? size * 3 - 1 : size * 2;
+}
+
+/**
+ * @brief Returns the number of bytes `hex_to_bytes` writes for `size`
+ * characters, rounded down when `size` is not a valid length.
+ */
+inline size_t hex_decoded_size(size_t size, char separator = '\0') {
+  return separator != '\0' ? (size + 1) / 3 : size / 2;
+}
+
+/**
+ * @brief Write the bytes as hex digits, in upper case unless
+ * `is_upper_case` is false, with `separator` between bytes unless it is
+ * '\0'. Returns the position after the last character; no terminating null
+ * is written. The output needs room for `hex_size(size, separator)`
+ * characters.
+ */
+inline char *bytes_to_hex(const uint8_t *data, size_t size, char *output,
+                          char separator = '\0', bool is_upper_case = true) {
+  size_t done = 0;
+#if defined(__SSSE3__)
+  const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+      is_upper_case ? "0123456789ABCDEF" : "0123456789abcdef"));
+  if (separator != '\0') {
+    done = detail::bytes_to_hex_separated_simd(data, size, output, separator,
+                                               digits);
+    output += done * 3;
+  } else {
+    done = detail::bytes_to_hex_simd(data, size, output, digits);
+    output += done * 2;
+  }
+#endif
+  return detail::bytes_to_hex_scalar(data + done, size - done, output,
+                                     separator, is_upper_case);
+}
+
+/**
+ * @brief Returns the bytes as a string of hex digits. The defaults give the
+ * same string as C#'s `BitConverter.ToString`, such as "0A-1B-FF".
+ */
+inline std::string to_hex_string(const uint8_t *data, size_t size,
+                                 char separator = '-',
+                                 bool is_upper_case = true) {
+  std::string hex(hex_size(size, separator), '\0');
+  bytes_to_hex(data, size, &hex[0], separator, is_upper_case);
+  return hex;
+}
+
+/**
+ * @brief Decode `size` characters of hex digits in either case, separated
+ * by `separator` unless it is '\0', into `hex_decoded_size(size, separator)`
+ * bytes. Returns false when the length is not one `bytes_to_hex` produces,
+ * a character that should be a digit is not one, or a separator is missing;
+ * the output is then left partly written.
+ */
+inline bool hex_to_bytes(const char *input, size_t size, uint8_t *output,
+                         char separator = '\0') {
+  const size_t count = hex_decoded_size(size, separator);
+  if (size != hex_size(count, separator)) {
+    return false;
+  }
+  size_t done = 0;
+  bool valid = true;
+#if defined(__SSSE3__)
+  if (separator != '\0') {
+    done = detail::hex_to_bytes_separated_simd(input, count, output, separator,
+                                               valid);
+    input += done * 3;
+  } else {
+    done = detail::hex_to_bytes_simd(input, count, output, valid);
+    input += done * 2;
+  }
+#endif
+  return valid && detail::hex_to_bytes_scalar(input, count - done,
+                                              output + done, separator);
+}
+
+}; // namespace bit_converter
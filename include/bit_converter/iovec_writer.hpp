@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <limits.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+/**
+ * @brief Builds a message as a list of `iovec` segments for `writev` or
+ * `sendmsg`. Small fields are encoded into an internal slab, while large
+ * payloads are referenced where they are, without being copied.
+ *
+ * Referenced payloads must stay alive until the message has been written.
+ */
+class iovec_writer {
+public:
+  /**
+   * @brief Payloads shorter than this are copied into the slab by `write`,
+   * since an extra segment costs more than copying a few bytes.
+   */
+  static constexpr size_t copy_threshold = 256;
+
+  iovec_writer() { slab.reserve(1024); }
+
+  /**
+   * @brief Encode `size` bytes into the slab by calling `encode` with a
+   * pointer to them, e.g. with `u32_to_bytes`.
+   */
+  template <typename F> void encode(size_t size, F &&encode) {
+    size_t offset = slab.size();
+    slab.resize(offset + size);
+    encode(slab.data() + offset);
+    add_inline(offset, size);
+  }
+
+  /**
+   * @brief Encode an integer or floating-point value into the slab.
+   */
+  template <typename T> void write_value(T value, bool is_big_endian) {
+    encode(sizeof(T), [&](uint8_t *output) {
+      values_to_bytes(&value, 1, is_big_endian, output);
+    });
+  }
+
+  /**
+   * @brief Append the bytes, copying them into the slab when they are shorter
+   * than `copy_threshold` and referencing them otherwise.
+   */
+  void write(const void *data, size_t size) {
+    if (size < copy_threshold) {
+      copy(data, size);
+    } else {
+      reference(data, size);
+    }
+  }
+
+  /**
+   * @brief Copy the bytes into the slab.
+   */
+  void copy(const void *data, size_t size) {
+    encode(size, [&](uint8_t *output) {
+      if (size > 0) {
+        std::memcpy(output, data, size);
+      }
+    });
+  }
+
+  /**
+   * @brief Append a segment that points at the caller's bytes.
+   */
+  void reference(const void *data, size_t size) {
+    if (size == 0) {
+      return;
+    }
+    segments.push_back({static_cast<const uint8_t *>(data), 0, size});
+    total += size;
+  }
+
+  /**
+   * @brief Returns the segments of the message. The pointers stay valid until
+   * the writer is modified.
+   */
+  const std::vector<iovec> &iovecs() {
+    vectors.clear();
+    for (const auto &segment : segments) {
+      const uint8_t *base = segment.data != nullptr
+                                ? segment.data
+                                : slab.data() + segment.slab_offset;
+      vectors.push_back({const_cast<uint8_t *>(base), segment.size});
+    }
+    return vectors;
+  }
+
+  /**
+   * @brief The total number of bytes in the message.
+   */
+  size_t size() const { return total; }
+
+  /**
+   * @brief Forget the message but keep the allocated memory.
+   */
+  void clear() {
+    slab.clear();
+    segments.clear();
+    vectors.clear();
+    total = 0;
+  }
+
+  /**
+   * @brief Write the message to `fd` with `writev`, starting `offset` bytes
+   * in and resuming after partial writes and interrupted calls. Returns the
+   * number of bytes written by this call. When an error such as `EAGAIN` on a
+   * non-blocking socket stops it early, that count is still returned with
+   * `errno` set, so the caller can resume at `offset` plus the count; -1 is
+   * returned only when nothing was written.
+   */
+  ssize_t write_to(int fd, size_t offset = 0) {
+    std::vector<iovec> pending = iovecs();
+    size_t first = 0;
+    auto skip = [&](size_t left) {
+      while (first < pending.size() && left >= pending[first].iov_len) {
+        left -= pending[first].iov_len;
+        first++;
+      }
+      if (left > 0) {
+        pending[first].iov_base =
+            static_cast<uint8_t *>(pending[first].iov_base) + left;
+        pending[first].iov_len -= left;
+      }
+    };
+    skip(offset);
+    size_t written = 0;
+    while (first < pending.size()) {
+      int count = static_cast<int>(std::min<size_t>(pending.size() - first,
+                                                    max_iovecs()));
+      ssize_t result = ::writev(fd, pending.data() + first, count);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return written > 0 ? static_cast<ssize_t>(written) : -1;
+      }
+      written += static_cast<size_t>(result);
+      skip(static_cast<size_t>(result));
+    }
+    return static_cast<ssize_t>(written);
+  }
+
+private:
+  struct segment {
+    // Points at a referenced payload, or is null for bytes in the slab.
+    const uint8_t *data;
+    size_t slab_offset;
+    size_t size;
+  };
+
+  static size_t max_iovecs() {
+#if defined(IOV_MAX)
+    return IOV_MAX;
+#else
+    return 1024;
+#endif
+  }
+
+  void add_inline(size_t offset, size_t size) {
+    if (size == 0) {
+      return;
+    }
+    if (!segments.empty() && segments.back().data == nullptr) {
+      // Adjacent inline fields share one segment.
+      segments.back().size += size;
+    } else {
+      segments.push_back({nullptr, offset, size});
+    }
+    total += size;
+  }
+
+  std::vector<uint8_t> slab;
+  std::vector<segment> segments;
+  std::vector<iovec> vectors;
+  size_t total = 0;
+};
+
+}; // namespace bit_converter
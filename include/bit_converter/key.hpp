@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+namespace detail {
+
+/**
+ * @brief Map a value to an unsigned integer of the same size whose unsigned
+ * order is the order of the values. Signed integers have their sign bit
+ * flipped. Floating-point numbers follow the IEEE 754 total order: positive
+ * numbers get their sign bit set, and negative numbers have all of their
+ * bits inverted.
+ */
+template <typename T> inline uint_of_size<T> to_ordered_bits(T value) {
+  using U = uint_of_size<T>;
+  constexpr U sign = U(1) << (sizeof(T) * 8 - 1);
+  U bits = bit_cast<U>(value);
+  if constexpr (std::is_floating_point<T>::value) {
+    U mask = static_cast<U>(-static_cast<U>(bits >> (sizeof(T) * 8 - 1)));
+    return static_cast<U>(bits ^ (mask | sign));
+  } else if constexpr (std::is_signed<T>::value) {
+    return static_cast<U>(bits ^ sign);
+  } else {
+    return bits;
+  }
+}
+
+template <typename T> inline T from_ordered_bits(uint_of_size<T> bits) {
+  using U = uint_of_size<T>;
+  constexpr U sign = U(1) << (sizeof(T) * 8 - 1);
+  if constexpr (std::is_floating_point<T>::value) {
+    // A clear top bit marks a negative number, whose bits were all inverted.
+    U mask = static_cast<U>(static_cast<U>(bits >> (sizeof(T) * 8 - 1)) - 1);
+    return bit_cast<T>(static_cast<U>(bits ^ (mask | sign)));
+  } else if constexpr (std::is_signed<T>::value) {
+    return bit_cast<T>(static_cast<U>(bits ^ sign));
+  } else {
+    return bits;
+  }
+}
+
+}; // namespace detail
+
+/**
+ * @brief Convert the value to a big-endian key whose bytes compare with
+ * `memcmp` in the same order as the values: negative integers sort before
+ * positive ones, and floating-point numbers follow the IEEE 754 total order,
+ * in which -0 sorts before +0 and NaNs sort at either end by their sign.
+ */
+template <typename T, typename OutputIt>
+inline OutputIt value_to_key(T value, OutputIt output_it) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "value_to_key needs an integer or floating-point type");
+  auto bits = detail::to_ordered_bits(value);
+  return values_to_bytes(&bits, 1, true, output_it);
+}
+
+/**
+ * @brief Returns the value of a key written by `value_to_key`.
+ */
+template <typename T, typename InputIt>
+inline T key_to_value(InputIt input_it) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "key_to_value needs an integer or floating-point type");
+  detail::uint_of_size<T> bits;
+  bytes_to_values(input_it, 1, true, &bits);
+  return detail::from_ordered_bits<T>(bits);
+}
+
+/**
+ * @brief Convert an array of values to keys, as `value_to_key` would do for
+ * each value in turn.
+ */
+template <typename T, typename OutputIt>
+inline OutputIt values_to_keys(const T *values, size_t count,
+                               OutputIt output_it) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "values_to_keys needs an integer or floating-point type");
+  using U = detail::uint_of_size<T>;
+  constexpr size_t chunk = detail::bulk_chunk_bytes / sizeof(T);
+  U bits[chunk];
+  for (size_t offset = 0; offset < count; offset += chunk) {
+    size_t n = std::min(count - offset, chunk);
+    for (size_t i = 0; i < n; i++) {
+      bits[i] = detail::to_ordered_bits(values[offset + i]);
+    }
+    output_it = values_to_bytes(static_cast<const U *>(bits), n, true,
+                                output_it);
+  }
+  return output_it;
+}
+
+/**
+ * @brief Convert `count` keys back to values, as `key_to_value` would do for
+ * each key in turn. Returns the position after the last key.
+ */
+template <typename T, typename InputIt>
+inline InputIt keys_to_values(InputIt input_it, size_t count, T *values) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "keys_to_values needs an integer or floating-point type");
+  using U = detail::uint_of_size<T>;
+  constexpr size_t chunk = detail::bulk_chunk_bytes / sizeof(T);
+  U bits[chunk];
+  for (size_t offset = 0; offset < count; offset += chunk) {
+    size_t n = std::min(count - offset, chunk);
+    input_it = bytes_to_values(input_it, n, true, bits);
+    for (size_t i = 0; i < n; i++) {
+      values[offset + i] = detail::from_ordered_bits<T>(bits[i]);
+    }
+  }
+  return input_it;
+}
+
+}; // namespace bit_converter
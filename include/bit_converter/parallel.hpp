@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+/**
+ * @brief Arrays smaller than this many bytes are converted on the calling
+ * thread; waking the workers would cost more than the conversion.
+ */
+constexpr size_t parallel_cutoff_bytes = 1 << 20;
+
+/**
+ * @brief The number of bytes each task converts, small enough to stay in the
+ * L2 cache of the core that runs it.
+ */
+constexpr size_t parallel_chunk_bytes = 256 << 10;
+
+/**
+ * @brief A fixed set of worker threads that run the tasks of one
+ * `parallel_for` at a time. Tasks are claimed from a shared atomic counter, so
+ * a thread that finishes early keeps taking work from the others.
+ */
+class thread_pool {
+public:
+  /**
+   * @brief Create a pool in which `thread_count` threads, including the one
+   * calling `parallel_for`, share the work.
+   */
+  explicit thread_pool(size_t thread_count = default_thread_count()) {
+    for (size_t i = 1; i < thread_count; i++) {
+      workers.emplace_back([this] { work(); });
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      is_stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  size_t size() const { return workers.size() + 1; }
+
+  static size_t default_thread_count() {
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+  /**
+   * @brief Call `task(i)` for every `i` in `[0, task_count)` and return when
+   * all calls have finished. The tasks must not throw.
+   */
+  template <typename F> void parallel_for(size_t task_count, F &&task) {
+    if (workers.empty() || task_count <= 1) {
+      for (size_t i = 0; i < task_count; i++) {
+        task(i);
+      }
+      return;
+    }
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      using Task = typename std::remove_reference<F>::type;
+      Task *task_pointer = &task;
+      context = const_cast<void *>(static_cast<const void *>(task_pointer));
+      invoke = [](void *f, size_t i) { (*static_cast<Task *>(f))(i); };
+      tasks = task_count;
+      next.store(0, std::memory_order_relaxed);
+      active = workers.size();
+      generation++;
+    }
+    wake.notify_all();
+    run_tasks();
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return active == 0; });
+  }
+
+private:
+  void run_tasks() {
+    for (;;) {
+      size_t i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= tasks) {
+        break;
+      }
+      invoke(context, i);
+    }
+  }
+
+  void work() {
+    size_t seen = 0;
+    for (;;) {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&] { return is_stopping || generation != seen; });
+      if (is_stopping) {
+        return;
+      }
+      seen = generation;
+      lock.unlock();
+      run_tasks();
+      lock.lock();
+      if (--active == 0) {
+        done.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> workers;
+  std::mutex run_mutex;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  void *context = nullptr;
+  void (*invoke)(void *, size_t) = nullptr;
+  size_t tasks = 0;
+  std::atomic<size_t> next{0};
+  size_t active = 0;
+  size_t generation = 0;
+  bool is_stopping = false;
+};
+
+namespace detail {
+
+/**
+ * @brief Split `count` values into cache-sized chunks and run `convert` on
+ * each, on the pool when the array is large enough.
+ */
+template <typename T, typename Convert>
+inline void for_each_chunk(size_t count, thread_pool &pool, Convert convert) {
+  if (count * sizeof(T) < parallel_cutoff_bytes || pool.size() == 1) {
+    convert(0, count);
+    return;
+  }
+  const size_t chunk = parallel_chunk_bytes / sizeof(T);
+  pool.parallel_for((count + chunk - 1) / chunk, [&](size_t i) {
+    size_t offset = i * chunk;
+    convert(offset, std::min(count - offset, chunk));
+  });
+}
+
+}; // namespace detail
+
+/**
+ * @brief `values_to_bytes` that splits large arrays across the pool.
+ */
+template <typename T>
+inline uint8_t *values_to_bytes(const T *values, size_t count,
+                                bool is_big_endian, uint8_t *output,
+                                thread_pool &pool) {
+  detail::for_each_chunk<T>(count, pool, [&](size_t offset, size_t n) {
+    values_to_bytes(values + offset, n, is_big_endian,
+                    output + offset * sizeof(T));
+  });
+  return output + count * sizeof(T);
+}
+
+/**
+ * @brief `bytes_to_values` that splits large arrays across the pool.
+ */
+template <typename T>
+inline const uint8_t *bytes_to_values(const uint8_t *input, size_t count,
+                                      bool is_big_endian, T *values,
+                                      thread_pool &pool) {
+  detail::for_each_chunk<T>(count, pool, [&](size_t offset, size_t n) {
+    bytes_to_values(input + offset * sizeof(T), n, is_big_endian,
+                    values + offset);
+  });
+  return input + count * sizeof(T);
+}
+
+}; // namespace bit_converter
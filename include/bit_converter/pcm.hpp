@@ -0,0 +1,314 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "detail.hpp"
+
+namespace bit_converter {
+
+using std::size_t;
+
+enum class pcm_format {
+  // Signed 16-bit samples.
+  s16,
+  // Signed 24-bit samples packed in three bytes.
+  s24
+};
+
+inline size_t pcm_sample_size(pcm_format format) {
+  return format == pcm_format::s16 ? 2 : 3;
+}
+
+namespace detail {
+
+template <pcm_format Format> struct pcm_traits;
+
+template <> struct pcm_traits<pcm_format::s16> {
+  static constexpr size_t size = 2;
+  static constexpr float scale = 32768.0f;
+  static constexpr float max = 32767.0f;
+  // How many samples past the last one the vector loads may read.
+  static constexpr size_t overread = 0;
+};
+
+template <> struct pcm_traits<pcm_format::s24> {
+  static constexpr size_t size = 3;
+  static constexpr float scale = 8388608.0f;
+  static constexpr float max = 8388607.0f;
+  static constexpr size_t overread = 2;
+};
+
+template <pcm_format Format, bool BigEndian>
+inline int32_t load_sample(const uint8_t *input) {
+  if constexpr (Format == pcm_format::s16) {
+    uint16_t raw = load_unaligned<uint16_t>(input);
+    return static_cast<int16_t>(BigEndian == is_little_endian_host
+                                    ? byte_swap(raw)
+                                    : raw);
+  } else {
+    uint32_t raw = BigEndian ? uint32_t(input[0]) << 16 |
+                                   uint32_t(input[1]) << 8 | input[2]
+                             : uint32_t(input[2]) << 16 |
+                                   uint32_t(input[1]) << 8 | input[0];
+    return static_cast<int32_t>(raw << 8) >> 8;
+  }
+}
+
+template <pcm_format Format, bool BigEndian>
+inline void store_sample(uint8_t *output, int32_t sample) {
+  if constexpr (Format == pcm_format::s16) {
+    uint16_t raw = static_cast<uint16_t>(sample);
+    store_unaligned(output, BigEndian == is_little_endian_host ? byte_swap(raw)
+                                                               : raw);
+  } else {
+    uint32_t raw = static_cast<uint32_t>(sample);
+    output[BigEndian ? 2 : 0] = static_cast<uint8_t>(raw);
+    output[1] = static_cast<uint8_t>(raw >> 8);
+    output[BigEndian ? 0 : 2] = static_cast<uint8_t>(raw >> 16);
+  }
+}
+
+/**
+ * @brief Scale to the sample range, saturate and round to nearest, ties to
+ * even. NaN becomes silence.
+ */
+template <pcm_format Format> inline int32_t to_sample(float value) {
+  using traits = pcm_traits<Format>;
+  float scaled = value * traits::scale;
+  if (std::isnan(scaled)) {
+    return 0;
+  }
+  scaled = std::min(std::max(scaled, -traits::scale), traits::max);
+  return static_cast<int32_t>(std::rint(scaled));
+}
+
+#if defined(__AVX2__)
+
+/**
+ * @brief Load eight samples and convert them to normalized floats.
+ */
+template <pcm_format Format, bool BigEndian>
+inline __m256 load_pcm_lanes(const uint8_t *input) {
+  __m256i samples;
+  if constexpr (Format == pcm_format::s16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+    if (BigEndian) {
+      v = _mm_shuffle_epi8(v, _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11,
+                                            10, 13, 12, 15, 14));
+    }
+    samples = _mm256_cvtepi16_epi32(v);
+  } else {
+    __m256i v = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(input))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 12)), 1);
+    // Move each sample to the top three bytes of a lane and shift it back
+    // down to extend its sign.
+    const __m256i spread =
+        BigEndian ? _mm256_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1,
+                                     11, 10, 9, -1, 2, 1, 0, -1, 5, 4, 3, -1, 8,
+                                     7, 6, -1, 11, 10, 9)
+                  : _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1,
+                                     9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6,
+                                     7, 8, -1, 9, 10, 11);
+    samples = _mm256_srai_epi32(_mm256_shuffle_epi8(v, spread), 8);
+  }
+  return _mm256_mul_ps(_mm256_cvtepi32_ps(samples),
+                       _mm256_set1_ps(1.0f / pcm_traits<Format>::scale));
+}
+
+inline void store_12_bytes(uint8_t *output, __m128i v) {
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(output), v);
+  uint32_t last = static_cast<uint32_t>(_mm_extract_epi32(v, 2));
+  std::memcpy(output + 8, &last, 4);
+}
+
+/**
+ * @brief Convert eight floats to samples as `to_sample` does and store them.
+ */
+template <pcm_format Format, bool BigEndian>
+inline void store_pcm_lanes(uint8_t *output, __m256 values) {
+  using traits = pcm_traits<Format>;
+  __m256 scaled = _mm256_mul_ps(values, _mm256_set1_ps(traits::scale));
+  __m256 ordered = _mm256_cmp_ps(scaled, scaled, _CMP_ORD_Q);
+  scaled = _mm256_min_ps(_mm256_max_ps(scaled, _mm256_set1_ps(-traits::scale)),
+                         _mm256_set1_ps(traits::max));
+  __m256i samples = _mm256_cvtps_epi32(_mm256_and_ps(scaled, ordered));
+  if constexpr (Format == pcm_format::s16) {
+    __m128i v = _mm_packs_epi32(_mm256_castsi256_si128(samples),
+                                _mm256_extracti128_si256(samples, 1));
+    if (BigEndian) {
+      v = _mm_shuffle_epi8(v, _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11,
+                                            10, 13, 12, 15, 14));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output), v);
+  } else {
+    const __m256i pack =
+        BigEndian
+            ? _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                               -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                               -1, -1, -1, -1)
+            : _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1,
+                               -1, -1, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14,
+                               -1, -1, -1, -1);
+    __m256i v = _mm256_shuffle_epi8(samples, pack);
+    store_12_bytes(output, _mm256_castsi256_si128(v));
+    store_12_bytes(output + 12, _mm256_extracti128_si256(v, 1));
+  }
+}
+
+#endif
+
+template <pcm_format Format, bool BigEndian>
+inline void decode_pcm(const uint8_t *input, size_t frames, size_t channels,
+                       float *const *planes) {
+  using traits = pcm_traits<Format>;
+  size_t frame = 0;
+#if defined(__AVX2__)
+  constexpr size_t size = traits::size;
+  if (channels == 1) {
+    for (; frame + 8 + traits::overread <= frames; frame += 8) {
+      _mm256_storeu_ps(planes[0] + frame,
+                       load_pcm_lanes<Format, BigEndian>(input + frame * size));
+    }
+  } else if (channels == 2) {
+    for (; (frame + 8) * 2 + traits::overread <= frames * 2; frame += 8) {
+      const uint8_t *source = input + frame * 2 * size;
+      __m256 a = load_pcm_lanes<Format, BigEndian>(source);
+      __m256 b = load_pcm_lanes<Format, BigEndian>(source + 8 * size);
+      // Even lanes are left samples and odd lanes right ones; the shuffles
+      // leave the halves of each lane in the order 0, 2, 1, 3.
+      __m256d left = _mm256_castps_pd(
+          _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+      __m256d right = _mm256_castps_pd(
+          _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+      _mm256_storeu_ps(planes[0] + frame,
+                       _mm256_castpd_ps(_mm256_permute4x64_pd(
+                           left, _MM_SHUFFLE(3, 1, 2, 0))));
+      _mm256_storeu_ps(planes[1] + frame,
+                       _mm256_castpd_ps(_mm256_permute4x64_pd(
+                           right, _MM_SHUFFLE(3, 1, 2, 0))));
+    }
+  }
+#endif
+  for (; frame < frames; frame++) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      int32_t sample = load_sample<Format, BigEndian>(
+          input + (frame * channels + channel) * traits::size);
+      planes[channel][frame] =
+          static_cast<float>(sample) * (1.0f / traits::scale);
+    }
+  }
+}
+
+template <pcm_format Format, bool BigEndian>
+inline void encode_pcm(const float *const *planes, size_t frames,
+                       size_t channels, uint8_t *output) {
+  using traits = pcm_traits<Format>;
+  size_t frame = 0;
+#if defined(__AVX2__)
+  constexpr size_t size = traits::size;
+  if (channels == 1) {
+    for (; frame + 8 <= frames; frame += 8) {
+      store_pcm_lanes<Format, BigEndian>(output + frame * size,
+                                         _mm256_loadu_ps(planes[0] + frame));
+    }
+  } else if (channels == 2) {
+    for (; frame + 8 <= frames; frame += 8) {
+      __m256 left = _mm256_loadu_ps(planes[0] + frame);
+      __m256 right = _mm256_loadu_ps(planes[1] + frame);
+      __m256 low = _mm256_unpacklo_ps(left, right);
+      __m256 high = _mm256_unpackhi_ps(left, right);
+      uint8_t *target = output + frame * 2 * size;
+      store_pcm_lanes<Format, BigEndian>(
+          target, _mm256_permute2f128_ps(low, high, 0x20));
+      store_pcm_lanes<Format, BigEndian>(
+          target + 8 * size, _mm256_permute2f128_ps(low, high, 0x31));
+    }
+  }
+#endif
+  for (; frame < frames; frame++) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      store_sample<Format, BigEndian>(
+          output + (frame * channels + channel) * traits::size,
+          to_sample<Format>(planes[channel][frame]));
+    }
+  }
+}
+
+/**
+ * @brief Call `f` with the format and the byte order as compile-time
+ * constants.
+ */
+template <typename F>
+inline void with_pcm_format(pcm_format format, bool is_big_endian, F &&f) {
+  using std::integral_constant;
+  using s16 = integral_constant<pcm_format, pcm_format::s16>;
+  using s24 = integral_constant<pcm_format, pcm_format::s24>;
+  if (format == pcm_format::s16) {
+    is_big_endian ? f(s16(), std::true_type()) : f(s16(), std::false_type());
+  } else {
+    is_big_endian ? f(s24(), std::true_type()) : f(s24(), std::false_type());
+  }
+}
+
+}; // namespace detail
+
+/**
+ * @brief Convert interleaved PCM samples of `channels` channels to
+ * normalized floats in [-1, 1), one array per channel. `planes[c]` receives
+ * the `frames` samples of channel `c`.
+ */
+inline void pcm_to_float_planes(const uint8_t *input, size_t frames,
+                                size_t channels, pcm_format format,
+                                bool is_big_endian, float *const *planes) {
+  detail::with_pcm_format(format, is_big_endian, [&](auto f, auto e) {
+    detail::decode_pcm<decltype(f)::value, decltype(e)::value>(
+        input, frames, channels, planes);
+  });
+}
+
+/**
+ * @brief Convert PCM samples to normalized floats in [-1, 1), keeping the
+ * channels interleaved.
+ */
+inline void pcm_to_float(const uint8_t *input, size_t samples,
+                         pcm_format format, bool is_big_endian,
+                         float *output) {
+  pcm_to_float_planes(input, samples, 1, format, is_big_endian, &output);
+}
+
+/**
+ * @brief Convert one float array per channel to interleaved PCM samples.
+ * Values are scaled by 2^15 or 2^23, rounded to nearest with ties to even,
+ * and saturated to the sample range, so 1.0 becomes the largest sample. NaN
+ * becomes 0.
+ */
+inline void float_planes_to_pcm(const float *const *planes, size_t frames,
+                                size_t channels, pcm_format format,
+                                bool is_big_endian, uint8_t *output) {
+  detail::with_pcm_format(format, is_big_endian, [&](auto f, auto e) {
+    detail::encode_pcm<decltype(f)::value, decltype(e)::value>(
+        planes, frames, channels, output);
+  });
+}
+
+/**
+ * @brief Convert floats to PCM samples as `float_planes_to_pcm` does,
+ * keeping their order.
+ */
+inline void float_to_pcm(const float *input, size_t samples, pcm_format format,
+                         bool is_big_endian, uint8_t *output) {
+  float_planes_to_pcm(&input, samples, 1, format, is_big_endian, output);
+}
+
+}; // namespace bit_converter
@@ -0,0 +1,339 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+/**
+ * @brief An affine mapping between floating-point values and integers: a
+ * value `x` is stored as `round(x * scale + offset)` and read back as
+ * `(q - offset) / scale`.
+ */
+template <typename F> struct quantization {
+  static_assert(std::is_floating_point<F>::value,
+                "quantization needs a floating-point type");
+  F scale = 1;
+  F offset = 0;
+};
+
+namespace detail {
+
+template <typename Q>
+using is_quantized_type =
+    std::integral_constant<bool, std::is_integral<Q>::value &&
+                                     !std::is_same<Q, bool>::value &&
+                                     sizeof(Q) <= 4>;
+
+/**
+ * @brief One past the largest value of `Q` as an `F`, which is exact, since
+ * it is a power of two.
+ */
+template <typename Q, typename F> constexpr F quantized_limit() {
+  return static_cast<F>(std::numeric_limits<Q>::max() / 2 + 1) * 2;
+}
+
+/**
+ * @brief Round to nearest, ties to even, and saturate to the range of `Q`.
+ * NaN becomes 0.
+ */
+template <typename Q, typename F> inline Q to_quantized(F value) {
+  F rounded = std::rint(value);
+  if (std::isnan(rounded)) {
+    return 0;
+  }
+  if (rounded <= static_cast<F>(std::numeric_limits<Q>::min())) {
+    return std::numeric_limits<Q>::min();
+  }
+  if (rounded >= quantized_limit<Q, F>()) {
+    return std::numeric_limits<Q>::max();
+  }
+  return static_cast<Q>(rounded);
+}
+
+template <typename Q, typename F>
+inline void quantize_scalar(const F *values, size_t count, bool is_big_endian,
+                            F scale, F offset, uint8_t *output) {
+  using U = uint_of_size<Q>;
+  bool swap = needs_byte_swap(is_big_endian);
+  for (size_t i = 0; i < count; i++) {
+    U raw = static_cast<U>(to_quantized<Q>(values[i] * scale + offset));
+    store_unaligned(output + i * sizeof(Q), swap ? byte_swap(raw) : raw);
+  }
+}
+
+template <typename Q, typename F>
+inline void dequantize_scalar(const uint8_t *input, size_t count,
+                              bool is_big_endian, F inverse_scale, F offset,
+                              F *values) {
+  using U = uint_of_size<Q>;
+  bool swap = needs_byte_swap(is_big_endian);
+  for (size_t i = 0; i < count; i++) {
+    U raw = load_unaligned<U>(input + i * sizeof(Q));
+    Q value = static_cast<Q>(swap ? byte_swap(raw) : raw);
+    values[i] = (static_cast<F>(value) - offset) * inverse_scale;
+  }
+}
+
+#if defined(__AVX2__)
+
+/**
+ * @brief Whether eight values of `Q` fit in the 32-bit lanes of a register,
+ * which excludes only `uint32_t`.
+ */
+template <typename Q>
+using is_avx2_quantized_type =
+    std::integral_constant<bool, sizeof(Q) < 4 || std::is_signed<Q>::value>;
+
+template <size_t Size> inline __m128i swap_lane_bytes(__m128i v) {
+  if constexpr (Size == 2) {
+    return _mm_shuffle_epi8(v, _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11,
+                                             10, 13, 12, 15, 14));
+  } else {
+    return _mm_shuffle_epi8(v, _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9,
+                                             8, 15, 14, 13, 12));
+  }
+}
+
+/**
+ * @brief The bounds the rounded values are clamped to before they are
+ * truncated to 32 bits: the smallest value of `Q` and the largest `F` below
+ * its limit. Rounded values at or above the limit are replaced by the
+ * largest value of `Q` afterwards, as it may have no exact `F`.
+ */
+template <typename Q, typename F> struct quantized_bounds {
+  F low = static_cast<F>(std::numeric_limits<Q>::min());
+  F high = std::nextafter(quantized_limit<Q, F>(), F(0));
+};
+
+inline __m256 set_lanes(float value) { return _mm256_set1_ps(value); }
+inline __m256d set_lanes(double value) { return _mm256_set1_pd(value); }
+
+/**
+ * @brief Scale, round and saturate eight values into 32-bit lanes.
+ */
+template <typename Q>
+inline __m256i quantize_lanes(const float *values, __m256 scale, __m256 offset,
+                              const quantized_bounds<Q, float> &bounds) {
+  __m256 scaled =
+      _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(values), scale), offset);
+  __m256 rounded = _mm256_round_ps(scaled, _MM_FROUND_TO_NEAREST_INT |
+                                               _MM_FROUND_NO_EXC);
+  // Zero the NaNs.
+  rounded = _mm256_and_ps(rounded, _mm256_cmp_ps(rounded, rounded, _CMP_ORD_Q));
+  __m256 over = _mm256_cmp_ps(
+      rounded, _mm256_set1_ps(quantized_limit<Q, float>()), _CMP_GE_OQ);
+  __m256 clamped =
+      _mm256_min_ps(_mm256_max_ps(rounded, _mm256_set1_ps(bounds.low)),
+                    _mm256_set1_ps(bounds.high));
+  return _mm256_blendv_epi8(
+      _mm256_cvttps_epi32(clamped),
+      _mm256_set1_epi32(static_cast<int32_t>(std::numeric_limits<Q>::max())),
+      _mm256_castps_si256(over));
+}
+
+template <typename Q>
+inline __m256i quantize_lanes(const double *values, __m256d scale,
+                              __m256d offset,
+                              const quantized_bounds<Q, double> &bounds) {
+  __m128i halves[2];
+  for (int k = 0; k < 2; k++) {
+    __m256d scaled = _mm256_add_pd(
+        _mm256_mul_pd(_mm256_loadu_pd(values + 4 * k), scale), offset);
+    __m256d rounded = _mm256_round_pd(scaled, _MM_FROUND_TO_NEAREST_INT |
+                                                  _MM_FROUND_NO_EXC);
+    rounded =
+        _mm256_and_pd(rounded, _mm256_cmp_pd(rounded, rounded, _CMP_ORD_Q));
+    // The limits of the supported types are exact in a double, so clamping
+    // alone saturates.
+    __m256d clamped =
+        _mm256_min_pd(_mm256_max_pd(rounded, _mm256_set1_pd(bounds.low)),
+                      _mm256_set1_pd(bounds.high));
+    halves[k] = _mm256_cvttpd_epi32(clamped);
+  }
+  return _mm256_setr_m128i(halves[0], halves[1]);
+}
+
+/**
+ * @brief Narrow eight saturated 32-bit lanes to `Q` and store them.
+ */
+template <typename Q, bool Swap>
+inline void store_quantized(uint8_t *output, __m256i lanes) {
+  if constexpr (sizeof(Q) == 4) {
+    __m128i low = _mm256_castsi256_si128(lanes);
+    __m128i high = _mm256_extracti128_si256(lanes, 1);
+    if (Swap) {
+      low = swap_lane_bytes<4>(low);
+      high = swap_lane_bytes<4>(high);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output), low);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16), high);
+  } else {
+    // The lanes are in range already, so the saturating packs only narrow.
+    __m128i low = _mm256_castsi256_si128(lanes);
+    __m128i high = _mm256_extracti128_si256(lanes, 1);
+    __m128i words = std::is_same<Q, uint16_t>::value
+                        ? _mm_packus_epi32(low, high)
+                        : _mm_packs_epi32(low, high);
+    if constexpr (sizeof(Q) == 2) {
+      if (Swap) {
+        words = swap_lane_bytes<2>(words);
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output), words);
+    } else {
+      __m128i bytes = std::is_signed<Q>::value ? _mm_packs_epi16(words, words)
+                                               : _mm_packus_epi16(words, words);
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(output), bytes);
+    }
+  }
+}
+
+/**
+ * @brief Load eight values of `Q` and widen them to 32-bit lanes.
+ */
+template <typename Q, bool Swap>
+inline __m256i load_quantized(const uint8_t *input) {
+  if constexpr (sizeof(Q) == 4) {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+    __m128i high =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16));
+    if (Swap) {
+      low = swap_lane_bytes<4>(low);
+      high = swap_lane_bytes<4>(high);
+    }
+    return _mm256_setr_m128i(low, high);
+  } else if constexpr (sizeof(Q) == 2) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+    if (Swap) {
+      v = swap_lane_bytes<2>(v);
+    }
+    return std::is_signed<Q>::value ? _mm256_cvtepi16_epi32(v)
+                                    : _mm256_cvtepu16_epi32(v);
+  } else {
+    __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(input));
+    return std::is_signed<Q>::value ? _mm256_cvtepi8_epi32(v)
+                                    : _mm256_cvtepu8_epi32(v);
+  }
+}
+
+inline void store_dequantized(float *values, __m256i lanes, __m256 inverse,
+                              __m256 offset) {
+  _mm256_storeu_ps(values, _mm256_mul_ps(_mm256_sub_ps(
+                                             _mm256_cvtepi32_ps(lanes), offset),
+                                         inverse));
+}
+
+inline void store_dequantized(double *values, __m256i lanes, __m256d inverse,
+                              __m256d offset) {
+  __m256d low = _mm256_cvtepi32_pd(_mm256_castsi256_si128(lanes));
+  __m256d high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(lanes, 1));
+  _mm256_storeu_pd(values, _mm256_mul_pd(_mm256_sub_pd(low, offset), inverse));
+  _mm256_storeu_pd(values + 4,
+                   _mm256_mul_pd(_mm256_sub_pd(high, offset), inverse));
+}
+
+/**
+ * @brief Quantize whole groups of eight values. Returns the number of values
+ * written.
+ */
+template <typename Q, bool Swap, typename F>
+inline size_t quantize_avx2(const F *values, size_t count, F scale, F offset,
+                            uint8_t *output) {
+  const quantized_bounds<Q, F> bounds;
+  const auto scale_lanes = set_lanes(scale);
+  const auto offset_lanes = set_lanes(offset);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    store_quantized<Q, Swap>(
+        output + i * sizeof(Q),
+        quantize_lanes<Q>(values + i, scale_lanes, offset_lanes, bounds));
+  }
+  return i;
+}
+
+template <typename Q, bool Swap, typename F>
+inline size_t dequantize_avx2(const uint8_t *input, size_t count,
+                              F inverse_scale, F offset, F *values) {
+  const auto inverse_lanes = set_lanes(inverse_scale);
+  const auto offset_lanes = set_lanes(offset);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    store_dequantized(values + i,
+                      load_quantized<Q, Swap>(input + i * sizeof(Q)),
+                      inverse_lanes, offset_lanes);
+  }
+  return i;
+}
+
+#endif
+
+}; // namespace detail
+
+/**
+ * @brief Encode each value as the integer `round(value * scale + offset)`
+ * of type `Q`, rounding to nearest with ties to even and saturating to the
+ * range of `Q`, in the requested byte order. NaN becomes 0. Returns the
+ * position after the last value.
+ */
+template <typename Q, typename F>
+inline uint8_t *quantize_to_bytes(const F *values, size_t count,
+                                  bool is_big_endian,
+                                  const quantization<F> &params,
+                                  uint8_t *output) {
+  static_assert(detail::is_quantized_type<Q>::value,
+                "quantize_to_bytes needs an integer type of up to 4 bytes");
+  size_t done = 0;
+#if defined(__AVX2__)
+  if constexpr (detail::is_avx2_quantized_type<Q>::value) {
+    done = detail::needs_byte_swap(is_big_endian)
+               ? detail::quantize_avx2<Q, true>(values, count, params.scale,
+                                                params.offset, output)
+               : detail::quantize_avx2<Q, false>(values, count, params.scale,
+                                                 params.offset, output);
+  }
+#endif
+  detail::quantize_scalar<Q>(values + done, count - done, is_big_endian,
+                             params.scale, params.offset,
+                             output + done * sizeof(Q));
+  return output + count * sizeof(Q);
+}
+
+/**
+ * @brief Decode `count` integers of type `Q` and map each back to
+ * `(q - offset) / scale`. The division is done as a multiplication by
+ * `1 / scale`. Returns the position after the last value.
+ */
+template <typename Q, typename F>
+inline const uint8_t *dequantize_bytes(const uint8_t *input, size_t count,
+                                       bool is_big_endian,
+                                       const quantization<F> &params,
+                                       F *values) {
+  static_assert(detail::is_quantized_type<Q>::value,
+                "dequantize_bytes needs an integer type of up to 4 bytes");
+  const F inverse_scale = 1 / params.scale;
+  size_t done = 0;
+#if defined(__AVX2__)
+  if constexpr (detail::is_avx2_quantized_type<Q>::value) {
+    done = detail::needs_byte_swap(is_big_endian)
+               ? detail::dequantize_avx2<Q, true>(input, count, inverse_scale,
+                                                  params.offset, values)
+               : detail::dequantize_avx2<Q, false>(input, count, inverse_scale,
+                                                   params.offset, values);
+  }
+#endif
+  detail::dequantize_scalar<Q>(input + done * sizeof(Q), count - done,
+                               is_big_endian, inverse_scale, params.offset,
+                               values + done);
+  return input + count * sizeof(Q);
+}
+
+}; // namespace bit_converter
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "key.hpp"
+
+namespace bit_converter {
+
+namespace detail {
+
+constexpr size_t radix_buckets = 256;
+
+/**
+ * @brief Move each record to the next free position of the bucket of its
+ * byte at `digit`. A nonzero `RecordSize` lets the compiler copy the records
+ * with fixed-size moves.
+ */
+template <size_t RecordSize>
+inline void scatter_records(const uint8_t *source, size_t count,
+                            size_t record_size, size_t digit, size_t *offsets,
+                            uint8_t *target) {
+  const size_t size = RecordSize != 0 ? RecordSize : record_size;
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t *record = source + i * size;
+    size_t &position = offsets[record[digit]];
+    std::memcpy(target + position * size, record, size);
+    position++;
+  }
+}
+
+inline void scatter_records(const uint8_t *source, size_t count,
+                            size_t record_size, size_t digit, size_t *offsets,
+                            uint8_t *target) {
+  switch (record_size) {
+  case 2:
+    return scatter_records<2>(source, count, 2, digit, offsets, target);
+  case 4:
+    return scatter_records<4>(source, count, 4, digit, offsets, target);
+  case 8:
+    return scatter_records<8>(source, count, 8, digit, offsets, target);
+  case 12:
+    return scatter_records<12>(source, count, 12, digit, offsets, target);
+  case 16:
+    return scatter_records<16>(source, count, 16, digit, offsets, target);
+  case 24:
+    return scatter_records<24>(source, count, 24, digit, offsets, target);
+  case 32:
+    return scatter_records<32>(source, count, 32, digit, offsets, target);
+  default:
+    return scatter_records<0>(source, count, record_size, digit, offsets,
+                              target);
+  }
+}
+
+}; // namespace detail
+
+/**
+ * @brief Sort `count` records of `record_size` bytes each by their first
+ * `key_size` bytes, compared as `memcmp` does, such as the keys written by
+ * `value_to_key`. The sort is stable, so the rest of each record can carry a
+ * payload or a secondary key. `scratch` must have room for all the records.
+ *
+ * This is a least significant digit radix sort over the key bytes. The
+ * counts of every byte position are gathered in a single pass, and a byte
+ * position where all records agree is skipped without moving them.
+ */
+inline void radix_sort_records(uint8_t *records, size_t count,
+                               size_t record_size, size_t key_size,
+                               uint8_t *scratch) {
+  if (count < 2 || key_size == 0) {
+    return;
+  }
+  std::vector<size_t> counts(key_size * detail::radix_buckets);
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t *record = records + i * record_size;
+    for (size_t digit = 0; digit < key_size; digit++) {
+      counts[digit * detail::radix_buckets + record[digit]]++;
+    }
+  }
+
+  uint8_t *source = records;
+  uint8_t *target = scratch;
+  for (size_t digit = key_size; digit-- > 0;) {
+    size_t *offsets = &counts[digit * detail::radix_buckets];
+    // The byte of any record is the byte of all records when it is constant.
+    if (offsets[records[digit]] == count) {
+      continue;
+    }
+    size_t position = 0;
+    for (size_t bucket = 0; bucket < detail::radix_buckets; bucket++) {
+      size_t n = offsets[bucket];
+      offsets[bucket] = position;
+      position += n;
+    }
+    detail::scatter_records(source, count, record_size, digit, offsets,
+                            target);
+    std::swap(source, target);
+  }
+  if (source != records) {
+    std::memcpy(records, source, count * record_size);
+  }
+}
+
+/**
+ * @brief Sort `count` keys of `key_size` bytes each, as `radix_sort_records`
+ * does for records that hold only a key.
+ */
+inline void radix_sort_keys(uint8_t *keys, size_t count, size_t key_size,
+                            uint8_t *scratch) {
+  radix_sort_records(keys, count, key_size, key_size, scratch);
+}
+
+}; // namespace bit_converter
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+/**
+ * @brief The sum type of a reduction: 64-bit integers of the same signedness
+ * for integers, which wrap on overflow, and `double` for floating point.
+ */
+template <typename T>
+using reduction_sum_t = typename std::conditional<
+    std::is_floating_point<T>::value, double,
+    typename std::conditional<std::is_signed<T>::value, int64_t,
+                              uint64_t>::type>::type;
+
+/**
+ * @brief The aggregates of an encoded array. NaNs add to the sum but are
+ * skipped by `min` and `max`; with no other values, `min` is greater than
+ * `max`.
+ */
+template <typename T> struct reduction {
+  reduction_sum_t<T> sum = 0;
+  T min = initial_min();
+  T max = initial_max();
+  size_t count = 0;
+
+  static constexpr T initial_min() {
+    return std::numeric_limits<T>::has_infinity
+               ? std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::max();
+  }
+
+  static constexpr T initial_max() {
+    return std::numeric_limits<T>::has_infinity
+               ? -std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::lowest();
+  }
+};
+
+namespace detail {
+
+template <typename S, typename T> inline S add_wrapping(S sum, T value) {
+  if constexpr (std::is_floating_point<S>::value) {
+    return sum + static_cast<S>(value);
+  } else {
+    using U = typename std::make_unsigned<S>::type;
+    return static_cast<S>(static_cast<U>(sum) +
+                          static_cast<U>(static_cast<S>(value)));
+  }
+}
+
+template <typename T>
+inline void reduce_scalar(const uint8_t *input, size_t count,
+                          bool is_big_endian, reduction<T> &result) {
+  using U = uint_of_size<T>;
+  bool swap = needs_byte_swap(is_big_endian);
+  for (size_t i = 0; i < count; i++) {
+    U raw = load_unaligned<U>(input + i * sizeof(T));
+    T value = bit_cast<T>(swap ? byte_swap(raw) : raw);
+    result.sum = add_wrapping(result.sum, value);
+    result.min = value < result.min ? value : result.min;
+    result.max = value > result.max ? value : result.max;
+  }
+}
+
+#if defined(__AVX2__)
+
+template <bool Swap> inline __m256i load_u64x4(const uint8_t *input) {
+  __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input));
+  if (Swap) {
+    const __m256i reverse = _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2,
+        1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    v = _mm256_shuffle_epi8(v, reverse);
+  }
+  return v;
+}
+
+/**
+ * @brief Reduce whole groups of eight values in registers with two sets of
+ * accumulators. Returns the number of values consumed.
+ */
+template <bool Swap>
+inline size_t reduce_avx2(const uint8_t *input, size_t count,
+                          reduction<int64_t> &result) {
+  __m256i sum[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+  __m256i min[2] = {_mm256_set1_epi64x(result.min),
+                    _mm256_set1_epi64x(result.min)};
+  __m256i max[2] = {_mm256_set1_epi64x(result.max),
+                    _mm256_set1_epi64x(result.max)};
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    for (int k = 0; k < 2; k++) {
+      __m256i v = load_u64x4<Swap>(input + (i + 4 * k) * 8);
+      sum[k] = _mm256_add_epi64(sum[k], v);
+      min[k] = _mm256_blendv_epi8(min[k], v, _mm256_cmpgt_epi64(min[k], v));
+      max[k] = _mm256_blendv_epi8(max[k], v, _mm256_cmpgt_epi64(v, max[k]));
+    }
+  }
+  alignas(32) int64_t lanes[3][4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[0]),
+                     _mm256_add_epi64(sum[0], sum[1]));
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[1]),
+                     _mm256_blendv_epi8(min[0], min[1],
+                                        _mm256_cmpgt_epi64(min[0], min[1])));
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[2]),
+                     _mm256_blendv_epi8(max[0], max[1],
+                                        _mm256_cmpgt_epi64(max[1], max[0])));
+  for (int lane = 0; lane < 4; lane++) {
+    result.sum = add_wrapping(result.sum, lanes[0][lane]);
+    result.min = std::min(result.min, lanes[1][lane]);
+    result.max = std::max(result.max, lanes[2][lane]);
+  }
+  return i;
+}
+
+template <bool Swap>
+inline size_t reduce_avx2(const uint8_t *input, size_t count,
+                          reduction<double> &result) {
+  __m256d sum[2] = {_mm256_setzero_pd(), _mm256_setzero_pd()};
+  __m256d min[2] = {_mm256_set1_pd(result.min), _mm256_set1_pd(result.min)};
+  __m256d max[2] = {_mm256_set1_pd(result.max), _mm256_set1_pd(result.max)};
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    for (int k = 0; k < 2; k++) {
+      __m256d v =
+          _mm256_castsi256_pd(load_u64x4<Swap>(input + (i + 4 * k) * 8));
+      sum[k] = _mm256_add_pd(sum[k], v);
+      // With a NaN in `v` these keep the accumulator.
+      min[k] = _mm256_min_pd(v, min[k]);
+      max[k] = _mm256_max_pd(v, max[k]);
+    }
+  }
+  alignas(32) double lanes[3][4];
+  _mm256_store_pd(lanes[0], _mm256_add_pd(sum[0], sum[1]));
+  _mm256_store_pd(lanes[1], _mm256_min_pd(min[0], min[1]));
+  _mm256_store_pd(lanes[2], _mm256_max_pd(max[0], max[1]));
+  for (int lane = 0; lane < 4; lane++) {
+    result.sum += lanes[0][lane];
+    result.min = std::min(result.min, lanes[1][lane]);
+    result.max = std::max(result.max, lanes[2][lane]);
+  }
+  return i;
+}
+
+#endif
+
+}; // namespace detail
+
+/**
+ * @brief Compute the sum, minimum, maximum and count of `count` encoded
+ * values in one pass, without storing the decoded values. For `int64_t` and
+ * `double` the values are byte-swapped and reduced in AVX2 registers.
+ *
+ * Floating-point sums are accumulated in several lanes, so they may differ
+ * from a sequential sum in the last bits.
+ */
+template <typename T>
+inline reduction<T> reduce_bytes(const uint8_t *input, size_t count,
+                                 bool is_big_endian) {
+  static_assert(detail::is_bulk_type<T>::value,
+                "reduce_bytes needs an integer or floating-point type");
+  reduction<T> result;
+  result.count = count;
+  size_t done = 0;
+#if defined(__AVX2__)
+  if constexpr (std::is_same<T, int64_t>::value ||
+                std::is_same<T, double>::value) {
+    done = detail::needs_byte_swap(is_big_endian)
+               ? detail::reduce_avx2<true>(input, count, result)
+               : detail::reduce_avx2<false>(input, count, result);
+  }
+#endif
+  detail::reduce_scalar(input + done * sizeof(T), count - done, is_big_endian,
+                        result);
+  return result;
+}
+
+}; // namespace bit_converter
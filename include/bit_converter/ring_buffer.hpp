@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+constexpr size_t cache_line_size = 64;
+
+/**
+ * @brief A lock-free byte ring buffer for exactly one producer thread and one
+ * consumer thread. Each side keeps its index on its own cache line along with
+ * a cached copy of the other side's index, which it refreshes only when the
+ * cached value is too small for the request at hand.
+ *
+ * Both sides work on contiguous regions of the ring and publish or consume
+ * many bytes at once, so the shared indices are touched once per batch.
+ */
+class spsc_ring {
+public:
+  /**
+   * @brief Create a ring of at least `capacity` bytes, rounded up to a power
+   * of two.
+   */
+  explicit spsc_ring(size_t capacity) : mask(round_up(capacity) - 1) {
+    buffer.reset(new uint8_t[mask + 1]);
+  }
+
+  spsc_ring(const spsc_ring &) = delete;
+  spsc_ring &operator=(const spsc_ring &) = delete;
+
+  size_t capacity() const { return mask + 1; }
+
+  /**
+   * @brief Producer: returns the contiguous free region up to the end of the
+   * ring and stores its size, which is 0 when the ring is full.
+   */
+  uint8_t *write_region(size_t &size) {
+    size_t tail = producer.index.load(std::memory_order_relaxed);
+    size_t offset = tail & mask;
+    if (capacity() - (tail - producer.cached) < capacity() - offset) {
+      producer.cached = consumer.index.load(std::memory_order_acquire);
+    }
+    size = std::min(capacity() - (tail - producer.cached), capacity() - offset);
+    return buffer.get() + offset;
+  }
+
+  /**
+   * @brief Producer: make the first `size` bytes of the free space visible to
+   * the consumer.
+   */
+  void publish(size_t size) {
+    size_t tail = producer.index.load(std::memory_order_relaxed);
+    producer.index.store(tail + size, std::memory_order_release);
+  }
+
+  /**
+   * @brief Producer: copy as many of the bytes as fit and publish them at
+   * once. Returns the number of bytes written.
+   */
+  size_t write(const void *data, size_t size) {
+    size_t tail = producer.index.load(std::memory_order_relaxed);
+    if (capacity() - (tail - producer.cached) < size) {
+      producer.cached = consumer.index.load(std::memory_order_acquire);
+    }
+    size = std::min(size, capacity() - (tail - producer.cached));
+    size_t offset = tail & mask;
+    size_t first = std::min(size, capacity() - offset);
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    std::memcpy(buffer.get() + offset, bytes, first);
+    std::memcpy(buffer.get(), bytes + first, size - first);
+    producer.index.store(tail + size, std::memory_order_release);
+    return size;
+  }
+
+  /**
+   * @brief Consumer: the number of bytes published and not yet consumed.
+   */
+  size_t readable() {
+    consumer.cached = producer.index.load(std::memory_order_acquire);
+    return consumer.cached - consumer.index.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Consumer: returns the contiguous readable region that starts
+   * `offset` bytes past the oldest unconsumed byte, and stores its size.
+   */
+  const uint8_t *read_region(size_t offset, size_t &size) {
+    size_t head = consumer.index.load(std::memory_order_relaxed) + offset;
+    if (consumer.cached - head == 0) {
+      consumer.cached = producer.index.load(std::memory_order_acquire);
+    }
+    size_t start = head & mask;
+    size = std::min(consumer.cached - head, capacity() - start);
+    return buffer.get() + start;
+  }
+
+  /**
+   * @brief Consumer: copy `size` readable bytes starting `offset` bytes past
+   * the oldest unconsumed byte, across the end of the ring if needed.
+   */
+  void peek(size_t offset, void *output, size_t size) const {
+    size_t start = (consumer.index.load(std::memory_order_relaxed) + offset) &
+                   mask;
+    size_t first = std::min(size, capacity() - start);
+    uint8_t *bytes = static_cast<uint8_t *>(output);
+    std::memcpy(bytes, buffer.get() + start, first);
+    std::memcpy(bytes + first, buffer.get(), size - first);
+  }
+
+  /**
+   * @brief Consumer: release the oldest `size` bytes to the producer.
+   */
+  void consume(size_t size) {
+    size_t head = consumer.index.load(std::memory_order_relaxed);
+    consumer.index.store(head + size, std::memory_order_release);
+  }
+
+  /**
+   * @brief Consumer: copy and consume up to `size` bytes. Returns the number
+   * of bytes read.
+   */
+  size_t read(void *output, size_t size) {
+    size = std::min(size, readable());
+    peek(0, output, size);
+    consume(size);
+    return size;
+  }
+
+private:
+  struct alignas(cache_line_size) side {
+    // Written only by the side that owns it.
+    std::atomic<size_t> index{0};
+    // The last value seen of the other side's index.
+    size_t cached = 0;
+  };
+
+  static size_t round_up(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  side producer;
+  side consumer;
+  alignas(cache_line_size) size_t mask;
+  std::unique_ptr<uint8_t[]> buffer;
+};
+
+/**
+ * @brief Consumer: decode up to `capacity` whole values straight out of the
+ * ring into `output` and consume their bytes. A value split by the end of the
+ * ring is copied out first. Returns the number of values decoded.
+ */
+template <typename T>
+inline size_t decode_from_ring(spsc_ring &ring, bool is_big_endian, T *output,
+                               size_t capacity) {
+  size_t count = std::min(ring.readable() / sizeof(T), capacity);
+  size_t done = 0;
+  while (done < count) {
+    size_t size;
+    const uint8_t *data = ring.read_region(done * sizeof(T), size);
+    size_t n = std::min(size / sizeof(T), count - done);
+    if (n == 0) {
+      uint8_t value[sizeof(T)];
+      ring.peek(done * sizeof(T), value, sizeof(T));
+      bytes_to_values(static_cast<const uint8_t *>(value), 1, is_big_endian,
+                      output + done);
+      n = 1;
+    } else {
+      bytes_to_values(data, n, is_big_endian, output + done);
+    }
+    done += n;
+  }
+  ring.consume(count * sizeof(T));
+  return count;
+}
+
+}; // namespace bit_converter
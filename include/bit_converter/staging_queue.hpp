@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "ring_buffer.hpp"
+
+namespace bit_converter {
+
+/**
+ * @brief A lock-free staging ring for many producer threads and one flusher
+ * thread. A producer reserves a record with a single `fetch_add` on the tail,
+ * encodes into it in place and commits it by storing its header. The flusher
+ * hands the committed records to a callback in reservation order and stops at
+ * the first record that is still being written.
+ *
+ * Every record is preceded by an 8-byte header and padded to 8 bytes. A record
+ * must not be larger than the ring. A producer waits while the ring is full.
+ */
+class mpsc_staging_queue {
+public:
+  struct slot {
+    uint8_t *data;
+    size_t size;
+    uint64_t *header;
+  };
+
+  /**
+   * @brief Create a ring of at least `capacity` bytes, rounded up to a power
+   * of two.
+   */
+  explicit mpsc_staging_queue(size_t capacity)
+      : mask(std::max<size_t>(round_up(capacity), 64) - 1),
+        storage(new uint64_t[(mask + 1) / 8]()) {}
+
+  mpsc_staging_queue(const mpsc_staging_queue &) = delete;
+  mpsc_staging_queue &operator=(const mpsc_staging_queue &) = delete;
+
+  size_t capacity() const { return mask + 1; }
+
+  /**
+   * @brief Producer: reserve `size` bytes of contiguous space. The flusher
+   * does not pass this record, or any later one, until it is committed.
+   */
+  slot reserve(size_t size) {
+    size_t length = (header_size + size + 7) & ~size_t(7);
+    for (;;) {
+      size_t position = tail.value.fetch_add(length, std::memory_order_relaxed);
+      wait_for_space(position + length);
+      size_t offset = position & mask;
+      if (offset + length <= capacity()) {
+        uint8_t *record = bytes() + offset;
+        return {record + header_size, size,
+                reinterpret_cast<uint64_t *>(record)};
+      }
+      // The record would cross the end of the ring; fill both parts with
+      // padding and reserve again.
+      store_header(offset, capacity() - offset, padding);
+      store_header(0, offset + length - capacity(), padding);
+    }
+  }
+
+  /**
+   * @brief Producer: publish a reserved record to the flusher.
+   */
+  void commit(const slot &record) {
+    uint64_t length = (header_size + record.size + 7) & ~uint64_t(7);
+    __atomic_store_n(record.header, length | uint64_t(record.size) << 32,
+                     __ATOMIC_RELEASE);
+  }
+
+  /**
+   * @brief Producer: reserve `size` bytes, encode them by calling `encode`
+   * with a pointer to them, e.g. with `i64_to_bytes`, and commit them.
+   */
+  template <typename F> void encode(size_t size, F &&encode) {
+    slot record = reserve(size);
+    encode(record.data);
+    commit(record);
+  }
+
+  /**
+   * @brief Flusher: call `on_record(data, size)` for every committed record
+   * in order, up to the first one that is not committed yet, and release
+   * their space. Returns the number of records passed.
+   */
+  template <typename F> size_t drain(F &&on_record) {
+    size_t start = head.value.load(std::memory_order_relaxed);
+    size_t position = start;
+    size_t count = 0;
+    for (;;) {
+      const uint8_t *record = bytes() + (position & mask);
+      uint64_t value = __atomic_load_n(
+          reinterpret_cast<const uint64_t *>(record), __ATOMIC_ACQUIRE);
+      if (value == 0) {
+        break;
+      }
+      size_t size = static_cast<size_t>(value >> 32);
+      if (size != padding) {
+        on_record(record + header_size, size);
+        count++;
+      }
+      position += static_cast<uint32_t>(value);
+      if (position - start >= capacity() / 4) {
+        // Let waiting producers continue during a long drain.
+        release(start, position);
+        start = position;
+      }
+    }
+    release(start, position);
+    return count;
+  }
+
+private:
+  static constexpr size_t header_size = 8;
+  static constexpr size_t padding = 0xFFFFFFFF;
+
+  struct alignas(cache_line_size) padded_index {
+    std::atomic<size_t> value{0};
+  };
+
+  static size_t round_up(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  uint8_t *bytes() { return reinterpret_cast<uint8_t *>(storage.get()); }
+
+  void wait_for_space(size_t end) {
+    while (end - head.value.load(std::memory_order_acquire) > capacity()) {
+      std::this_thread::yield();
+    }
+  }
+
+  void store_header(size_t offset, size_t length, size_t size) {
+    __atomic_store_n(reinterpret_cast<uint64_t *>(bytes() + offset),
+                     uint64_t(length) | uint64_t(size) << 32,
+                     __ATOMIC_RELEASE);
+  }
+
+  /**
+   * @brief Zero the drained bytes, so that headers written there later are
+   * seen as uncommitted until they are stored, and hand them back.
+   */
+  void release(size_t start, size_t end) {
+    if (end == start) {
+      return;
+    }
+    size_t offset = start & mask;
+    size_t first = std::min(end - start, capacity() - offset);
+    std::memset(bytes() + offset, 0, first);
+    std::memset(bytes(), 0, end - start - first);
+    head.value.store(end, std::memory_order_release);
+  }
+
+  padded_index tail;
+  padded_index head;
+  alignas(cache_line_size) size_t mask;
+  std::unique_ptr<uint64_t[]> storage;
+};
+
+}; // namespace bit_converter
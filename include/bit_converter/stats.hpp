@@ -0,0 +1,233 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(BIT_CONVERTER_ENABLE_STATS)
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace bit_converter {
+
+/**
+ * @brief Whether the converters count their calls. Define
+ * `BIT_CONVERTER_ENABLE_STATS` in every translation unit to turn the counters
+ * on; without it the counting compiles to nothing.
+ */
+#if defined(BIT_CONVERTER_ENABLE_STATS)
+constexpr bool is_stats_enabled = true;
+#else
+constexpr bool is_stats_enabled = false;
+#endif
+
+enum class stats_function {
+  i16_to_bytes,
+  u16_to_bytes,
+  i32_to_bytes,
+  u32_to_bytes,
+  i64_to_bytes,
+  u64_to_bytes,
+  f32_to_bytes,
+  f64_to_bytes,
+  bytes_to_i16,
+  bytes_to_u16,
+  bytes_to_i32,
+  bytes_to_u32,
+  bytes_to_i64,
+  bytes_to_u64,
+  bytes_to_f32,
+  bytes_to_f64,
+  values_to_bytes,
+  bytes_to_values,
+  count
+};
+
+enum class stats_path {
+  // One value through a plain byte pointer.
+  scalar,
+  // Byte by byte through a generic iterator.
+  iterator,
+  // A whole array copied with `memcpy`, as its byte order matches the host.
+  bulk_copy,
+  // A whole array byte-swapped in a loop the compiler vectorizes.
+  bulk_swap,
+  count
+};
+
+constexpr size_t stats_function_count =
+    static_cast<size_t>(stats_function::count);
+constexpr size_t stats_path_count = static_cast<size_t>(stats_path::count);
+
+inline const char *stats_function_name(stats_function function) {
+  static const char *const names[] = {
+      "i16_to_bytes",    "u16_to_bytes",   "i32_to_bytes", "u32_to_bytes",
+      "i64_to_bytes",    "u64_to_bytes",   "f32_to_bytes", "f64_to_bytes",
+      "bytes_to_i16",    "bytes_to_u16",   "bytes_to_i32", "bytes_to_u32",
+      "bytes_to_i64",    "bytes_to_u64",   "bytes_to_f32", "bytes_to_f64",
+      "values_to_bytes", "bytes_to_values"};
+  return names[static_cast<size_t>(function)];
+}
+
+inline const char *stats_path_name(stats_path path) {
+  static const char *const names[] = {"scalar", "iterator", "bulk_copy",
+                                      "bulk_swap"};
+  return names[static_cast<size_t>(path)];
+}
+
+struct function_stats {
+  uint64_t calls = 0;
+  uint64_t values = 0;
+  uint64_t bytes = 0;
+  // The number of calls that took each `stats_path`.
+  uint64_t paths[stats_path_count] = {};
+};
+
+/**
+ * @brief The counters of every converter, summed over threads.
+ */
+struct stats_snapshot {
+  function_stats functions[stats_function_count];
+
+  const function_stats &operator[](stats_function function) const {
+    return functions[static_cast<size_t>(function)];
+  }
+
+  stats_snapshot &operator+=(const stats_snapshot &other) {
+    for (size_t f = 0; f < stats_function_count; f++) {
+      functions[f].calls += other.functions[f].calls;
+      functions[f].values += other.functions[f].values;
+      functions[f].bytes += other.functions[f].bytes;
+      for (size_t p = 0; p < stats_path_count; p++) {
+        functions[f].paths[p] += other.functions[f].paths[p];
+      }
+    }
+    return *this;
+  }
+};
+
+#if defined(BIT_CONVERTER_ENABLE_STATS)
+
+namespace detail {
+
+struct thread_stats;
+
+/**
+ * @brief Keeps track of the counters of the running threads and of the sum
+ * left behind by the threads that have exited.
+ */
+class stats_registry {
+public:
+  static stats_registry &instance() {
+    static stats_registry registry;
+    return registry;
+  }
+
+  void add(thread_stats *thread) {
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.push_back(thread);
+  }
+
+  inline void remove(thread_stats *thread);
+  inline stats_snapshot collect();
+
+private:
+  std::mutex mutex;
+  std::vector<thread_stats *> threads;
+  stats_snapshot retired;
+};
+
+/**
+ * @brief The counters of one thread. Only the owning thread writes them, so
+ * an increment is a relaxed load and store rather than a locked add; other
+ * threads only read them.
+ */
+struct thread_stats {
+  struct counters {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> values{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> paths[stats_path_count] = {};
+  };
+
+  thread_stats() { stats_registry::instance().add(this); }
+  ~thread_stats() { stats_registry::instance().remove(this); }
+
+  static void add(std::atomic<uint64_t> &counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+  }
+
+  stats_snapshot snapshot() const {
+    stats_snapshot result;
+    for (size_t f = 0; f < stats_function_count; f++) {
+      result.functions[f].calls = functions[f].calls.load();
+      result.functions[f].values = functions[f].values.load();
+      result.functions[f].bytes = functions[f].bytes.load();
+      for (size_t p = 0; p < stats_path_count; p++) {
+        result.functions[f].paths[p] = functions[f].paths[p].load();
+      }
+    }
+    return result;
+  }
+
+  counters functions[stats_function_count];
+};
+
+inline void stats_registry::remove(thread_stats *thread) {
+  std::lock_guard<std::mutex> lock(mutex);
+  retired += thread->snapshot();
+  for (size_t i = 0; i < threads.size(); i++) {
+    if (threads[i] == thread) {
+      threads[i] = threads.back();
+      threads.pop_back();
+      break;
+    }
+  }
+}
+
+inline stats_snapshot stats_registry::collect() {
+  std::lock_guard<std::mutex> lock(mutex);
+  stats_snapshot result = retired;
+  for (const thread_stats *thread : threads) {
+    result += thread->snapshot();
+  }
+  return result;
+}
+
+inline void count_call(stats_function function, stats_path path,
+                       size_t values, size_t bytes) {
+  thread_local thread_stats stats;
+  auto &counters = stats.functions[static_cast<size_t>(function)];
+  thread_stats::add(counters.calls, 1);
+  thread_stats::add(counters.values, values);
+  thread_stats::add(counters.bytes, bytes);
+  thread_stats::add(counters.paths[static_cast<size_t>(path)], 1);
+}
+
+}; // namespace detail
+
+#define BIT_CONVERTER_COUNT(function, path, values, bytes)                     \
+  ::bit_converter::detail::count_call(                                         \
+      ::bit_converter::stats_function::function, path, values, bytes)
+
+/**
+ * @brief Sum the counters of all threads, including those that have exited.
+ */
+inline stats_snapshot collect_stats() {
+  return detail::stats_registry::instance().collect();
+}
+
+#else
+
+#define BIT_CONVERTER_COUNT(function, path, values, bytes) static_cast<void>(0)
+
+/**
+ * @brief Returns zeros, as the counters are compiled out.
+ */
+inline stats_snapshot collect_stats() { return stats_snapshot(); }
+
+#endif
+
+}; // namespace bit_converter
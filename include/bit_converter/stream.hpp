@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "bulk.hpp"
+
+namespace bit_converter {
+
+/**
+ * @brief Decodes fixed-width values from a byte stream that arrives in chunks
+ * of arbitrary size, such as the results of successive socket reads.
+ *
+ * Whole values are decoded straight out of the caller's chunk. Only the bytes
+ * of a value split across two chunks (at most `sizeof(T) - 1`) are copied and
+ * carried over to the next chunk.
+ */
+template <typename T> class stream_decoder {
+public:
+  explicit stream_decoder(bool is_big_endian) : is_big_endian(is_big_endian) {}
+
+  /**
+   * @brief Start decoding a new chunk. The previous chunk must be drained, and
+   * this one must stay alive until it is.
+   */
+  void feed(const uint8_t *data, size_t size) {
+    chunk = data;
+    remaining = size;
+  }
+
+  /**
+   * @brief Decode up to `capacity` values into `output` and return how many
+   * were written. Returns fewer than `capacity` only when the chunk is
+   * drained. A `capacity` of 0 decodes nothing and leaves any whole value in
+   * the chunk, so loops that read until `is_drained` need a non-zero
+   * capacity.
+   */
+  size_t read(T *output, size_t capacity) {
+    size_t produced = 0;
+    if (carry_size > 0 && capacity > 0) {
+      size_t take = std::min(sizeof(T) - carry_size, remaining);
+      std::memcpy(carry + carry_size, chunk, take);
+      carry_size += take;
+      advance(take);
+      if (carry_size < sizeof(T)) {
+        return 0;
+      }
+      bytes_to_values(static_cast<const uint8_t *>(carry), 1, is_big_endian,
+                      output);
+      carry_size = 0;
+      produced = 1;
+    }
+    size_t n = std::min(remaining / sizeof(T), capacity - produced);
+    bytes_to_values(chunk, n, is_big_endian, output + produced);
+    advance(n * sizeof(T));
+    produced += n;
+    if (remaining < sizeof(T) && carry_size == 0) {
+      std::memcpy(carry, chunk, remaining);
+      carry_size = remaining;
+      advance(remaining);
+    }
+    return produced;
+  }
+
+  /**
+   * @brief Feed a chunk and decode all of it, handing every batch of up to
+   * `capacity` values in `output` to `on_batch(output, count)`. `capacity`
+   * must be non-zero.
+   */
+  template <typename F>
+  void consume(const uint8_t *data, size_t size, T *output, size_t capacity,
+               F &&on_batch) {
+    assert(capacity > 0);
+    feed(data, size);
+    while (!is_drained()) {
+      size_t count = read(output, capacity);
+      if (count > 0) {
+        on_batch(static_cast<const T *>(output), count);
+      }
+    }
+  }
+
+  /**
+   * @brief Whether every byte of the current chunk has been decoded or
+   * carried over, so that the chunk may be released.
+   */
+  bool is_drained() const { return remaining == 0; }
+
+  /**
+   * @brief The number of bytes of an incomplete value waiting for the next
+   * chunk.
+   */
+  size_t carried_bytes() const { return carry_size; }
+
+private:
+  void advance(size_t size) {
+    chunk += size;
+    remaining -= size;
+  }
+
+  bool is_big_endian;
+  const uint8_t *chunk = nullptr;
+  size_t remaining = 0;
+  uint8_t carry[sizeof(T)] = {};
+  size_t carry_size = 0;
+};
+
+}; // namespace bit_converter
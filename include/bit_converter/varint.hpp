@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bit_converter {
+
+using std::size_t;
+
+/**
+ * @brief The maximum number of bytes of a 64-bit varint.
+ */
+constexpr size_t max_varint_size = 10;
+
+/**
+ * @brief Map a signed integer to an unsigned one so that values of small
+ * magnitude get small codes: 0, -1, 1, -2, 2, ... become 0, 1, 2, 3, 4, ...
+ */
+inline uint64_t zigzag_encode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+/**
+ * @brief The inverse of `zigzag_encode`.
+ */
+inline int64_t zigzag_decode(uint64_t value) {
+  return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+/**
+ * @brief Convert the specified 64-bit unsigned integer value to a LEB128
+ * varint: seven bits per byte, least significant group first, with the high
+ * bit of every byte but the last set.
+ */
+template <typename OutputIt>
+inline OutputIt u64_to_varint(uint64_t value, OutputIt output_it) {
+  while (value >= 0x80) {
+    *output_it = static_cast<uint8_t>(value | 0x80);
+    output_it++;
+    value = value >> 7;
+  }
+  *output_it = static_cast<uint8_t>(value);
+  output_it++;
+  return output_it;
+}
+
+/**
+ * @brief Convert the specified 64-bit signed integer value to a zigzag
+ * encoded varint.
+ */
+template <typename OutputIt>
+inline OutputIt i64_to_varint(int64_t value, OutputIt output_it) {
+  return u64_to_varint(zigzag_encode(value), output_it);
+}
+
+/**
+ * @brief Read a LEB128 varint into `value` and return the position after it.
+ */
+template <typename InputIt>
+inline InputIt varint_to_u64(InputIt input_it, uint64_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    uint8_t b = static_cast<uint8_t>(*input_it);
+    input_it++;
+    value = value | (static_cast<uint64_t>(b & 0x7F) << shift);
+    if (b < 0x80) {
+      break;
+    }
+  }
+  return input_it;
+}
+
+/**
+ * @brief Read a zigzag encoded varint into `value` and return the position
+ * after it.
+ */
+template <typename InputIt>
+inline InputIt varint_to_i64(InputIt input_it, int64_t &value) {
+  uint64_t code;
+  input_it = varint_to_u64(input_it, code);
+  value = zigzag_decode(code);
+  return input_it;
+}
+
+/**
+ * @brief Returns the number of bytes `u64_to_varint` writes for the value.
+ */
+inline size_t varint_size(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value = value >> 7;
+    size++;
+  }
+  return size;
+}
+
+}; // namespace bit_converter
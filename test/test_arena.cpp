@@ -0,0 +1,60 @@
+#include "bit_converter/arena.hpp"
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/bulk.hpp"
+#include <catch2/catch.hpp>
+
+using std::vector;
+
+TEST_CASE("test byte arena", "[arena]") {
+  bit_converter::byte_arena arena(1024);
+  SECTION("bump allocation") {
+    uint8_t *first = arena.allocate(100);
+    uint8_t *second = arena.allocate(100);
+    REQUIRE(second == first + 100);
+    REQUIRE(arena.extend(second, 100, 200));
+    REQUIRE_FALSE(arena.extend(first, 100, 200));
+    REQUIRE(arena.allocate(10) == second + 200);
+  }
+  SECTION("reset reuses the slabs") {
+    uint8_t *first = arena.allocate(1000);
+    arena.allocate(1000);
+    arena.allocate(5000);
+    size_t capacity = arena.capacity();
+    arena.reset();
+    REQUIRE(arena.allocate(1000) == first);
+    arena.allocate(1000);
+    arena.allocate(5000);
+    REQUIRE(arena.capacity() == capacity);
+  }
+}
+
+TEST_CASE("test arena buffer", "[arena]") {
+  bit_converter::byte_arena arena(256);
+  bit_converter::arena_buffer buffer(arena, 4);
+  bit_converter::i32_to_bytes(94356, true, std::back_inserter(buffer));
+  bit_converter::f64_to_bytes(3.14, false, std::back_inserter(buffer));
+  int16_t values[2] = {-4334, 30000};
+  bit_converter::values_to_bytes(values, 2, true, buffer.grow(4));
+  REQUIRE(vector<uint8_t>(buffer.begin(), buffer.end()) ==
+          vector<uint8_t>{0, 1, 112, 148, 31, 133, 235, 81, 184, 30, 9, 64, 239,
+                          18, 117, 48});
+
+  buffer.shrink_to_fit();
+  bit_converter::arena_buffer next(arena);
+  REQUIRE(next.data() == buffer.data() + buffer.size());
+
+  bit_converter::arena_buffer large(arena);
+  for (int i = 0; i < 1000; i++) {
+    bit_converter::u16_to_bytes(static_cast<uint16_t>(i), true,
+                                std::back_inserter(large));
+  }
+  REQUIRE(large.size() == 2000);
+  REQUIRE(bit_converter::bytes_to_u16(large.data() + 1998, true) == 999);
+
+  bit_converter::arena_buffer moved(std::move(large));
+  REQUIRE(moved.size() == 2000);
+  REQUIRE(large.size() == 0);
+  large.push_back(7);
+  REQUIRE(large.data() != moved.data());
+  REQUIRE(bit_converter::bytes_to_u16(moved.data() + 1998, true) == 999);
+}
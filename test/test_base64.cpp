@@ -0,0 +1,151 @@
+#include "bit_converter/base64.hpp"
+#include "bit_converter/bit_converter.hpp"
+#include "test_data.hpp"
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <string>
+
+using std::vector;
+
+namespace {
+
+/**
+ * @brief Encode three bytes at a time following RFC 4648.
+ */
+std::string reference_base64(const uint8_t *data, size_t size,
+                             bool is_url_safe, bool is_padded) {
+  std::string alphabet =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+  alphabet += is_url_safe ? "-_" : "+/";
+  std::string text;
+  for (size_t i = 0; i < size; i += 3) {
+    size_t n = std::min<size_t>(size - i, 3);
+    uint32_t bits = 0;
+    for (size_t k = 0; k < 3; k++) {
+      bits = bits << 8 | (k < n ? data[i + k] : 0);
+    }
+    for (size_t k = 0; k < 4; k++) {
+      if (k <= n) {
+        text += alphabet[(bits >> (18 - 6 * k)) & 0x3F];
+      } else if (is_padded) {
+        text += '=';
+      }
+    }
+  }
+  return text;
+}
+
+std::string encode(const std::string &text) {
+  return bit_converter::to_base64_string(
+      reinterpret_cast<const uint8_t *>(text.data()), text.size());
+}
+
+} // namespace
+
+TEST_CASE("test base64", "[base64]") {
+  SECTION("matches the RFC 4648 test vectors") {
+    REQUIRE(encode("").empty());
+    REQUIRE(encode("f") == "Zg==");
+    REQUIRE(encode("fo") == "Zm8=");
+    REQUIRE(encode("foo") == "Zm9v");
+    REQUIRE(encode("foob") == "Zm9vYg==");
+    REQUIRE(encode("fooba") == "Zm9vYmE=");
+    REQUIRE(encode("foobar") == "Zm9vYmFy");
+    const uint8_t bytes[] = {0xFB, 0xFF, 0xBF};
+    REQUIRE(bit_converter::to_base64_string(bytes, 3) == "+/+/");
+    REQUIRE(bit_converter::to_base64_string(bytes, 3, true) == "-_-_");
+    REQUIRE(bit_converter::to_base64_string(bytes, 1, true, false) == "-w");
+  }
+
+  SECTION("encodes and decodes every length") {
+    vector<uint8_t> bytes = test_data::make_bytes(300);
+    for (bool is_url_safe : {false, true}) {
+      for (bool is_padded : {true, false}) {
+        for (size_t size = 0; size <= bytes.size(); size++) {
+          std::string expected =
+              reference_base64(bytes.data(), size, is_url_safe, is_padded);
+          std::string text(bit_converter::base64_size(size, is_padded), '?');
+          REQUIRE(text.size() == expected.size());
+          char *end = bit_converter::bytes_to_base64(
+              bytes.data(), size, &text[0], is_url_safe, is_padded);
+          REQUIRE(end == &text[0] + text.size());
+          REQUIRE(text == expected);
+
+          REQUIRE(bit_converter::base64_decoded_size(text.data(),
+                                                     text.size()) == size);
+          vector<uint8_t> decoded(size);
+          REQUIRE(bit_converter::base64_to_bytes(text.data(), text.size(),
+                                                 decoded.data(), is_url_safe));
+          REQUIRE(std::equal(decoded.begin(), decoded.end(), bytes.begin()));
+        }
+      }
+    }
+  }
+
+  SECTION("rejects malformed input") {
+    vector<uint8_t> bytes = test_data::make_bytes(100);
+    vector<uint8_t> decoded(bytes.size());
+    for (bool is_url_safe : {false, true}) {
+      const std::string text = bit_converter::to_base64_string(
+          bytes.data(), bytes.size(), is_url_safe);
+      // Every position, in every SIMD block and the scalar tail, is checked.
+      for (size_t i = 0; i < text.size(); i++) {
+        for (char bad : {'=', '.', ' ', '\0', '\x80', '\xFF', '@', '[', '`',
+                         '{', is_url_safe ? '+' : '-',
+                         is_url_safe ? '/' : '_'}) {
+          std::string corrupt = text;
+          corrupt[i] = bad;
+          if (bad == text[i]) {
+            continue;
+          }
+          REQUIRE_FALSE(bit_converter::base64_to_bytes(
+              corrupt.data(), corrupt.size(), decoded.data(), is_url_safe));
+        }
+      }
+    }
+    REQUIRE_FALSE(bit_converter::base64_to_bytes("Zm9vY", 5, decoded.data()));
+    REQUIRE_FALSE(bit_converter::base64_to_bytes("Zm9v=", 5, decoded.data()));
+    REQUIRE_FALSE(
+        bit_converter::base64_to_bytes("Zm9v====", 8, decoded.data()));
+    REQUIRE_FALSE(bit_converter::base64_to_bytes("Zh==", 4, decoded.data()));
+    REQUIRE_FALSE(bit_converter::base64_to_bytes("Zm9=", 4, decoded.data()));
+    REQUIRE(bit_converter::base64_to_bytes("Zm8", 3, decoded.data()));
+  }
+
+  SECTION("encodes values without a byte buffer") {
+    vector<double> values(1000);
+    for (size_t i = 0; i < values.size(); i++) {
+      values[i] = static_cast<double>(i) * 1.25 - 300.0;
+    }
+    for (bool is_big_endian : {true, false}) {
+      for (size_t count : {1, 5, 383, 384, 385, 1000}) {
+        vector<uint8_t> bytes(count * sizeof(double));
+        bit_converter::values_to_bytes(values.data(), count, is_big_endian,
+                                       bytes.data());
+        std::string expected = bit_converter::to_base64_string(
+            bytes.data(), bytes.size(), true);
+
+        std::string text(bit_converter::base64_size(bytes.size()), '?');
+        char *end = bit_converter::values_to_base64(
+            values.data(), count, is_big_endian, &text[0], true);
+        REQUIRE(end == &text[0] + text.size());
+        REQUIRE(text == expected);
+
+        vector<double> decoded(count);
+        REQUIRE(bit_converter::base64_to_values(text.data(), text.size(),
+                                                decoded.data(), count,
+                                                is_big_endian, true));
+        REQUIRE(std::equal(decoded.begin(), decoded.end(), values.begin()));
+        REQUIRE_FALSE(bit_converter::base64_to_values(
+            text.data(), text.size(), decoded.data(), count - 1,
+            is_big_endian, true));
+      }
+    }
+    vector<int16_t> shorts = {1, -2, 300, -32768, 32767};
+    std::string text(bit_converter::base64_size(10), '?');
+    bit_converter::values_to_base64(shorts.data(), shorts.size(), true,
+                                    &text[0]);
+    REQUIRE(text == "AAH//gEsgAB//w==");
+  }
+}
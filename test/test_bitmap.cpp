@@ -0,0 +1,108 @@
+#include "bit_converter/bit_converter.hpp"
+#include <catch2/catch.hpp>
+
+using std::vector;
+
+TEST_CASE("test bits to bytes", "[bitmap]") {
+  vector<bool> bits{true, false, true, true, false, false, false, true,
+                    true, true, false};
+  SECTION("least significant bit first") {
+    vector<uint8_t> bytes;
+    bit_converter::bits_to_bytes(bits, false, std::back_inserter(bytes));
+    REQUIRE(bytes == vector<uint8_t>{0x8D, 0x03});
+  }
+  SECTION("most significant bit first") {
+    vector<uint8_t> bytes;
+    bit_converter::bits_to_bytes(bits, true, std::back_inserter(bytes));
+    REQUIRE(bytes == vector<uint8_t>{0xB1, 0xC0});
+  }
+  SECTION("bool array") {
+    bool array[11] = {true, false, true, true,  false, false,
+                      false, true, true, true, false};
+    vector<uint8_t> bytes(2);
+    bit_converter::bits_to_bytes(array, 11, false, bytes.data());
+    REQUIRE(bytes == vector<uint8_t>{0x8D, 0x03});
+    bit_converter::bits_to_bytes(array, 11, true, bytes.begin());
+    REQUIRE(bytes == vector<uint8_t>{0xB1, 0xC0});
+  }
+  SECTION("bitset") {
+    std::bitset<11> set("01110001101");
+    vector<uint8_t> bytes;
+    bit_converter::bitset_to_bytes(set, false, std::back_inserter(bytes));
+    REQUIRE(bytes == vector<uint8_t>{0x8D, 0x03});
+  }
+  SECTION("create bytes from bits drops the partial byte") {
+    vector<uint8_t> bytes;
+    bit_converter::create_bytes_from_bits(bits, std::back_inserter(bytes));
+    REQUIRE(bytes == vector<uint8_t>{0x8D});
+  }
+}
+
+TEST_CASE("test bytes to bits", "[bitmap]") {
+  vector<bool> bits{true, false, true, true, false, false, false, true,
+                    true, true, false};
+  SECTION("least significant bit first") {
+    vector<uint8_t> bytes{0x8D, 0x03};
+    REQUIRE(bit_converter::bytes_to_bits(bytes.begin(), 11, false) == bits);
+  }
+  SECTION("most significant bit first") {
+    vector<uint8_t> bytes{0xB1, 0xC0};
+    REQUIRE(bit_converter::bytes_to_bits(bytes.begin(), 11, true) == bits);
+  }
+  SECTION("bitset") {
+    vector<uint8_t> bytes{0x8D, 0x03};
+    REQUIRE(bit_converter::bytes_to_bitset<11>(bytes.begin(), false) ==
+            std::bitset<11>("01110001101"));
+  }
+}
+
+TEST_CASE("test bitmap round trip", "[bitmap]") {
+  const size_t bit_count = 1000;
+  bool array[bit_count];
+  vector<bool> bits(bit_count);
+  std::bitset<bit_count> set;
+  for (size_t i = 0; i < bit_count; i++) {
+    array[i] = (i * 7919 % 13) < 5;
+    bits[i] = array[i];
+    set[i] = array[i];
+  }
+  for (bool is_msb_first : {false, true}) {
+    vector<uint8_t> from_array((bit_count + 7) / 8);
+    vector<uint8_t> from_vector;
+    vector<uint8_t> from_bitset;
+    bit_converter::bits_to_bytes(array, bit_count, is_msb_first,
+                                 from_array.data());
+    bit_converter::bits_to_bytes(bits, is_msb_first,
+                                 std::back_inserter(from_vector));
+    bit_converter::bitset_to_bytes(set, is_msb_first,
+                                   std::back_inserter(from_bitset));
+    REQUIRE(from_vector == from_array);
+    REQUIRE(from_bitset == from_array);
+
+    bool decoded[bit_count];
+    bit_converter::bytes_to_bits(from_array.data(), bit_count, is_msb_first,
+                                 decoded);
+    REQUIRE(std::equal(decoded, decoded + bit_count, array));
+    REQUIRE(bit_converter::bytes_to_bits(from_array.begin(), bit_count,
+                                         is_msb_first) == bits);
+    REQUIRE(bit_converter::bytes_to_bitset<bit_count>(from_array.begin(),
+                                                      is_msb_first) == set);
+  }
+}
+
+TEST_CASE("test vector<bool> word layout", "[bitmap]") {
+  vector<bool> bits(130);
+  uint64_t *words = bit_converter::detail::vector_bool_words(bits);
+#if defined(__GLIBCXX__)
+  REQUIRE(words != nullptr);
+#endif
+  if (words != nullptr) {
+    bits[0] = bits[63] = bits[64] = bits[129] = true;
+    REQUIRE(words[0] == ((1ULL << 63) | 1));
+    REQUIRE(words[1] == 1);
+    REQUIRE(words[2] == 2);
+    words[1] = 1ULL << 5;
+    REQUIRE(!bits[64]);
+    REQUIRE(bits[69]);
+  }
+}
@@ -0,0 +1,66 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/bulk.hpp"
+#include <catch2/catch.hpp>
+
+using std::vector;
+
+TEST_CASE("test values to bytes", "[bulk]") {
+  vector<int32_t> values{94356, -1, 0, 2147483647};
+  for (bool is_big_endian : {true, false}) {
+    vector<uint8_t> expected(values.size() * sizeof(int32_t));
+    for (size_t i = 0; i < values.size(); i++) {
+      bit_converter::i32_to_bytes(values[i], is_big_endian,
+                                  expected.begin() + i * sizeof(int32_t));
+    }
+    vector<uint8_t> bytes(expected.size());
+    REQUIRE(bit_converter::values_to_bytes(values.data(), values.size(),
+                                           is_big_endian, bytes.data()) ==
+            bytes.data() + bytes.size());
+    REQUIRE(bytes == expected);
+
+    vector<uint8_t> appended;
+    bit_converter::values_to_bytes(values.data(), values.size(), is_big_endian,
+                                   std::back_inserter(appended));
+    REQUIRE(appended == expected);
+  }
+}
+
+TEST_CASE("test bytes to values", "[bulk]") {
+  vector<uint8_t> bytes{31, 133, 235, 81, 184, 30, 9, 64,
+                        0,  0,   0,   0,  0,   0,  0, 128};
+  SECTION("f64") {
+    vector<double> values(2);
+    bit_converter::bytes_to_values(bytes.begin(), values.size(), false,
+                                   values.data());
+    REQUIRE(values[0] == bit_converter::bytes_to_f64(bytes.begin(), false));
+    REQUIRE(std::signbit(values[1]));
+  }
+  SECTION("u16") {
+    vector<uint16_t> values(8);
+    auto end = bit_converter::bytes_to_values(
+        static_cast<const uint8_t *>(bytes.data()), values.size(), true,
+        values.data());
+    REQUIRE(end == bytes.data() + bytes.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      REQUIRE(values[i] ==
+              bit_converter::bytes_to_u16(bytes.begin() + i * 2, true));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("test bulk round trip", "[bulk]", int8_t, int16_t, uint32_t,
+                   int64_t, float, double) {
+  vector<TestType> values(10000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<TestType>(static_cast<int>(i * 7919 % 1000) - 500);
+  }
+  for (bool is_big_endian : {true, false}) {
+    vector<uint8_t> bytes;
+    bit_converter::values_to_bytes(values.data(), values.size(), is_big_endian,
+                                   std::back_inserter(bytes));
+    vector<TestType> decoded(values.size());
+    bit_converter::bytes_to_values(bytes.begin(), decoded.size(),
+                                   is_big_endian, decoded.data());
+    REQUIRE(decoded == values);
+  }
+}
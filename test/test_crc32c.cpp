@@ -0,0 +1,135 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/crc32c.hpp"
+#include "test_data.hpp"
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <string>
+
+using std::vector;
+
+namespace {
+
+/**
+ * @brief A bit-at-a-time CRC-32C.
+ */
+uint32_t reference_crc32c(const uint8_t *data, size_t size) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < size; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+} // namespace
+
+TEST_CASE("test crc32c", "[crc32c]") {
+  SECTION("check values") {
+    const std::string digits = "123456789";
+    REQUIRE(bit_converter::crc32c(digits.data(), digits.size()) == 0xE3069283);
+    REQUIRE(bit_converter::crc32c(nullptr, 0) == 0);
+    vector<uint8_t> zeros(32, 0);
+    REQUIRE(bit_converter::crc32c(zeros.data(), zeros.size()) == 0x8A9136AA);
+  }
+
+  SECTION("matches the bitwise definition at every length and alignment") {
+    vector<uint8_t> bytes = test_data::make_bytes(5000);
+    for (size_t offset = 0; offset < 8; offset++) {
+      for (size_t size = 0; size + offset <= bytes.size(); size += 13) {
+        uint32_t expected = reference_crc32c(bytes.data() + offset, size);
+        REQUIRE(bit_converter::crc32c(bytes.data() + offset, size) ==
+                expected);
+        REQUIRE(~bit_converter::detail::crc32c_update_table(
+                    0xFFFFFFFF, bytes.data() + offset, size) == expected);
+      }
+    }
+  }
+
+  SECTION("continues across pieces") {
+    vector<uint8_t> bytes = test_data::make_bytes(1000);
+    uint32_t whole = bit_converter::crc32c(bytes.data(), bytes.size());
+    for (size_t split : {0, 1, 5, 8, 13, 999, 1000}) {
+      uint32_t crc = bit_converter::crc32c(bytes.data(), split);
+      crc = bit_converter::crc32c(bytes.data() + split, bytes.size() - split,
+                                  crc);
+      REQUIRE(crc == whole);
+    }
+  }
+}
+
+TEST_CASE("test crc32c_writer and crc32c_reader", "[crc32c]") {
+  vector<int64_t> values;
+  for (int i = 0; i < 3000; i++) {
+    values.push_back(static_cast<int64_t>(i) * 0x9E3779B97F4A7C15LL);
+  }
+  const char header[] = "FRAME";
+
+  for (bool is_big_endian : {true, false}) {
+    vector<uint8_t> frame(8000 * 8);
+    bit_converter::crc32c_writer writer(frame.data());
+    writer.write(header, 5);
+    writer.write_value(uint32_t(values.size()), is_big_endian);
+    writer.write_value(int16_t(-2), is_big_endian);
+    writer.write_value(3.5, is_big_endian);
+    writer.write_values(values.data(), values.size(), is_big_endian);
+    REQUIRE(writer.size() == 5 + 4 + 2 + 8 + values.size() * 8);
+    REQUIRE(writer.position() == frame.data() + writer.size());
+
+    // The same bytes as the plain converters write.
+    vector<uint8_t> expected(frame.data(), frame.data() + 5);
+    uint8_t scalar[8];
+    bit_converter::u32_to_bytes(uint32_t(values.size()), is_big_endian, scalar);
+    expected.insert(expected.end(), scalar, scalar + 4);
+    bit_converter::i16_to_bytes(int16_t(-2), is_big_endian, scalar);
+    expected.insert(expected.end(), scalar, scalar + 2);
+    bit_converter::f64_to_bytes(3.5, is_big_endian, scalar);
+    expected.insert(expected.end(), scalar, scalar + 8);
+    for (int64_t value : values) {
+      bit_converter::i64_to_bytes(value, is_big_endian, scalar);
+      expected.insert(expected.end(), scalar, scalar + 8);
+    }
+    REQUIRE(vector<uint8_t>(frame.data(), writer.position()) == expected);
+    REQUIRE(writer.checksum() ==
+            bit_converter::crc32c(expected.data(), expected.size()));
+
+    bit_converter::crc32c_reader reader(frame.data(), writer.size());
+    char magic[5];
+    REQUIRE(reader.read(magic, 5));
+    REQUIRE(std::memcmp(magic, header, 5) == 0);
+    uint32_t count;
+    int16_t small;
+    double real;
+    REQUIRE(reader.read_value(count, is_big_endian));
+    REQUIRE(reader.read_value(small, is_big_endian));
+    REQUIRE(reader.read_value(real, is_big_endian));
+    REQUIRE(count == values.size());
+    REQUIRE(small == -2);
+    REQUIRE(real == 3.5);
+    vector<int64_t> decoded(count + 10);
+    REQUIRE(reader.read_values(decoded.data(), decoded.size(),
+                               is_big_endian) == count);
+    decoded.resize(count);
+    REQUIRE(decoded == values);
+    REQUIRE(reader.remaining() == 0);
+    REQUIRE(reader.checksum() == writer.checksum());
+
+    // Nothing is consumed past the end.
+    int64_t extra;
+    REQUIRE(!reader.read_value(extra, is_big_endian));
+    REQUIRE(!reader.read(magic, 1));
+    REQUIRE(reader.checksum() == writer.checksum());
+  }
+
+  SECTION("continues a checksum") {
+    uint8_t bytes[16];
+    bit_converter::crc32c_writer first(bytes);
+    first.write_value(uint64_t(1), true);
+    bit_converter::crc32c_writer second(bytes + 8, first.checksum());
+    second.write_value(uint64_t(2), true);
+    REQUIRE(second.checksum() == bit_converter::crc32c(bytes, 16));
+    REQUIRE(second.size() == 8);
+  }
+}
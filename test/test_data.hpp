@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace test_data {
+
+/**
+ * @brief Returns `size` bytes that cover every byte value in an irregular
+ * order.
+ */
+inline std::vector<uint8_t> make_bytes(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; i++) {
+    bytes[i] = static_cast<uint8_t>(i * 151 + (i >> 3));
+  }
+  return bytes;
+}
+
+}; // namespace test_data
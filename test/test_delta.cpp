@@ -0,0 +1,79 @@
+#include "bit_converter/delta.hpp"
+#include <catch2/catch.hpp>
+
+using std::vector;
+
+TEST_CASE("test delta encode", "[delta]") {
+  vector<int64_t> values{1000, 1010, 1020, 1031, 1041};
+  vector<int64_t> deltas(values.size());
+  SECTION("delta") {
+    bit_converter::delta_encode(values.data(), values.size(), deltas.data());
+    REQUIRE(deltas == vector<int64_t>{1000, 10, 10, 11, 10});
+  }
+  SECTION("delta of delta") {
+    bit_converter::delta_of_delta_encode(values.data(), values.size(),
+                                         deltas.data());
+    REQUIRE(deltas == vector<int64_t>{1000, 10, 0, 1, -1});
+  }
+}
+
+TEST_CASE("test delta decode", "[delta]") {
+  vector<int64_t> values(5);
+  SECTION("delta") {
+    vector<int64_t> deltas{1000, 10, 10, 11, 10};
+    bit_converter::delta_decode(deltas.data(), deltas.size(), values.data());
+    REQUIRE(values == vector<int64_t>{1000, 1010, 1020, 1031, 1041});
+  }
+  SECTION("delta of delta") {
+    vector<int64_t> deltas{1000, 10, 0, 1, -1};
+    bit_converter::delta_of_delta_decode(deltas.data(), deltas.size(),
+                                         values.data());
+    REQUIRE(values == vector<int64_t>{1000, 1010, 1020, 1031, 1041});
+  }
+}
+
+TEST_CASE("test delta round trip", "[delta]") {
+  vector<int64_t> timestamps(1000);
+  int64_t t = 1618000000000LL;
+  for (size_t i = 0; i < timestamps.size(); i++) {
+    t += 1000 + static_cast<int64_t>(i * 7919 % 5) - 2;
+    timestamps[i] = t;
+  }
+  timestamps[500] = INT64_MIN;
+  timestamps[501] = INT64_MAX;
+  vector<int64_t> decoded(timestamps.size());
+  SECTION("fixed width") {
+    vector<uint8_t> bytes;
+    bit_converter::delta_to_bytes(timestamps.data(), timestamps.size(), true,
+                                  std::back_inserter(bytes));
+    REQUIRE(bytes.size() == timestamps.size() * sizeof(int64_t));
+    bit_converter::bytes_to_delta(bytes.begin(), decoded.size(), true,
+                                  decoded.data());
+    REQUIRE(decoded == timestamps);
+
+    bytes.clear();
+    bit_converter::delta_of_delta_to_bytes(
+        timestamps.data(), timestamps.size(), false, std::back_inserter(bytes));
+    bit_converter::bytes_to_delta_of_delta(bytes.begin(), decoded.size(),
+                                           false, decoded.data());
+    REQUIRE(decoded == timestamps);
+  }
+  SECTION("varint") {
+    vector<uint8_t> bytes;
+    bit_converter::delta_to_varints(timestamps.data(), timestamps.size(),
+                                    std::back_inserter(bytes));
+    auto end = bit_converter::varints_to_delta(bytes.begin(), decoded.size(),
+                                               decoded.data());
+    REQUIRE(end == bytes.end());
+    REQUIRE(decoded == timestamps);
+
+    bytes.clear();
+    bit_converter::delta_of_delta_to_varints(
+        timestamps.data(), timestamps.size(), std::back_inserter(bytes));
+    REQUIRE(bytes.size() < timestamps.size() * 2);
+    end = bit_converter::varints_to_delta_of_delta(
+        bytes.begin(), decoded.size(), decoded.data());
+    REQUIRE(end == bytes.end());
+    REQUIRE(decoded == timestamps);
+  }
+}
@@ -1,5 +1,6 @@
 #include "bit_converter/bit_converter.hpp"
 #include <catch2/catch.hpp>
+#include <limits>
 
 using std::vector;
 
@@ -12,6 +13,14 @@ TEST_CASE("test f32 to bytes", "[f32]") {
   SECTION("floating-point numbers") {
     REQUIRE(get_bytes(3.14, false) == vector<uint8_t>{195, 245, 72, 64});
   }
+  SECTION("special values") {
+    REQUIRE(get_bytes(0.0, true) == vector<uint8_t>{0, 0, 0, 0});
+    REQUIRE(get_bytes(-0.0, false) == vector<uint8_t>{0, 0, 0, 128});
+    REQUIRE(get_bytes(std::numeric_limits<float>::infinity(), true) ==
+            vector<uint8_t>{127, 128, 0, 0});
+    REQUIRE(get_bytes(std::numeric_limits<float>::denorm_min(), false) ==
+            vector<uint8_t>{1, 0, 0, 0});
+  }
 }
 
 TEST_CASE("test bytes to f32", "[f32]") {
@@ -22,4 +31,12 @@ TEST_CASE("test bytes to f32", "[f32]") {
   SECTION("floating-point numbers") {
     REQUIRE(to_f32(vector<uint8_t>{195, 245, 72, 64}, false) == Approx(3.14F));
   }
+  SECTION("special values") {
+    REQUIRE(to_f32(vector<uint8_t>{0, 0, 0, 0}, true) == 0.0);
+    REQUIRE(to_f32(vector<uint8_t>{127, 128, 0, 0}, true) ==
+            std::numeric_limits<float>::infinity());
+    REQUIRE(to_f32(vector<uint8_t>{1, 0, 0, 0}, false) ==
+            std::numeric_limits<float>::denorm_min());
+    REQUIRE(std::isnan(to_f32(vector<uint8_t>{255, 255, 255, 255}, true)));
+  }
 }
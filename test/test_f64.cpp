@@ -1,5 +1,6 @@
 #include "bit_converter/bit_converter.hpp"
 #include <catch2/catch.hpp>
+#include <limits>
 
 using std::vector;
 
@@ -13,6 +14,14 @@ TEST_CASE("test f64 to bytes", "[f64]") {
     REQUIRE(get_bytes(3.14, false) ==
             vector<uint8_t>{31, 133, 235, 81, 184, 30, 9, 64});
   }
+  SECTION("special values") {
+    REQUIRE(get_bytes(0.0, true) == vector<uint8_t>{0, 0, 0, 0, 0, 0, 0, 0});
+    REQUIRE(get_bytes(-0.0, false) == vector<uint8_t>{0, 0, 0, 0, 0, 0, 0, 128});
+    REQUIRE(get_bytes(std::numeric_limits<double>::infinity(), true) ==
+            vector<uint8_t>{127, 240, 0, 0, 0, 0, 0, 0});
+    REQUIRE(get_bytes(std::numeric_limits<double>::denorm_min(), false) ==
+            vector<uint8_t>{1, 0, 0, 0, 0, 0, 0, 0});
+  }
 }
 
 TEST_CASE("test bytes to f64", "[f64]") {
@@ -24,4 +33,13 @@ TEST_CASE("test bytes to f64", "[f64]") {
     REQUIRE(to_f64(vector<uint8_t>{31, 133, 235, 81, 184, 30, 9, 64}, false) ==
             Approx(3.14));
   }
+  SECTION("special values") {
+    REQUIRE(to_f64(vector<uint8_t>{0, 0, 0, 0, 0, 0, 0, 0}, true) == 0.0);
+    REQUIRE(to_f64(vector<uint8_t>{127, 240, 0, 0, 0, 0, 0, 0}, true) ==
+            std::numeric_limits<double>::infinity());
+    REQUIRE(to_f64(vector<uint8_t>{1, 0, 0, 0, 0, 0, 0, 0}, false) ==
+            std::numeric_limits<double>::denorm_min());
+    REQUIRE(std::isnan(
+        to_f64(vector<uint8_t>{255, 255, 255, 255, 255, 255, 255, 255}, true)));
+  }
 }
@@ -0,0 +1,68 @@
+#include "bit_converter/bulk.hpp"
+#include "bit_converter/file_sink.hpp"
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using std::vector;
+
+namespace {
+
+vector<uint8_t> read_file(const char *path) {
+  std::ifstream file(path, std::ios::binary);
+  return vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                         std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+TEST_CASE("test file sink", "[file_sink]") {
+  char path[] = "/tmp/bit_converter_file_sink_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE(fd >= 0);
+  ::close(fd);
+
+  vector<int64_t> values(5000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<int64_t>(i * 0x9E3779B97F4A7C15ULL);
+  }
+  vector<uint8_t> expected{1, 2, 3};
+  bit_converter::values_to_bytes(values.data(), values.size(), true,
+                                 std::back_inserter(expected));
+
+  for (bool use_direct_io : {false, true}) {
+    bit_converter::file_sink::options config;
+    config.block_size = 4096;
+    config.use_direct_io = use_direct_io;
+    bit_converter::file_sink sink(path, config);
+    REQUIRE(sink.is_open());
+    // Three bytes first so that values straddle the block boundaries.
+    sink.write_bytes(expected.data(), 3);
+    sink.write_values(values.data(), values.size(), true);
+    REQUIRE(sink.close());
+    REQUIRE(sink.error() == 0);
+    REQUIRE(read_file(path) == expected);
+  }
+  std::remove(path);
+}
+
+TEST_CASE("test file sink rejects invalid block sizes", "[file_sink]") {
+  char path[] = "/tmp/bit_converter_file_sink_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE(fd >= 0);
+  ::close(fd);
+
+  for (size_t block_size : {size_t(0), size_t(1000)}) {
+    bit_converter::file_sink::options config;
+    config.block_size = block_size;
+    bit_converter::file_sink sink(path, config);
+    REQUIRE(!sink.is_open());
+    REQUIRE(sink.error() == EINVAL);
+    uint8_t bytes[] = {1, 2, 3};
+    sink.write_bytes(bytes, sizeof(bytes));
+    REQUIRE(!sink.close());
+  }
+  std::remove(path);
+}
@@ -0,0 +1,91 @@
+#include "bit_converter/bulk.hpp"
+#include "bit_converter/file_source.hpp"
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <iterator>
+
+using std::vector;
+
+namespace {
+
+void write_file(const char *path, const vector<uint8_t> &bytes) {
+  FILE *file = std::fopen(path, "wb");
+  std::fwrite(bytes.data(), 1, bytes.size(), file);
+  std::fclose(file);
+}
+
+} // namespace
+
+TEST_CASE("test decode file", "[file_source]") {
+  char path[] = "/tmp/bit_converter_file_source_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE(fd >= 0);
+  ::close(fd);
+
+  vector<int32_t> values(10000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<int32_t>(i * 2654435761U);
+  }
+  vector<uint8_t> bytes;
+  bit_converter::values_to_bytes(values.data(), values.size(), true,
+                                 std::back_inserter(bytes));
+  write_file(path, bytes);
+
+  for (bool use_io_uring : {false, true}) {
+    // 1000 is not a multiple of four, so values straddle the blocks.
+    for (size_t block_size : {size_t(1000), size_t(4096), size_t(1 << 20)}) {
+      bit_converter::file_source::options config;
+      config.block_size = block_size;
+      config.queue_depth = 3;
+      config.use_io_uring = use_io_uring;
+      vector<int32_t> decoded;
+      int error = bit_converter::decode_file<int32_t>(
+          path, true,
+          [&](const int32_t *batch, size_t count) {
+            decoded.insert(decoded.end(), batch, batch + count);
+          },
+          config);
+      REQUIRE(error == 0);
+      REQUIRE(decoded == values);
+    }
+  }
+
+  SECTION("blocks") {
+    bit_converter::file_source::options config;
+    config.block_size = 4096;
+    bit_converter::file_source source(path, config);
+    REQUIRE(source.size() == bytes.size());
+    vector<uint8_t> read;
+    const uint8_t *data;
+    size_t size;
+    while (source.next_block(data, size)) {
+      REQUIRE(size <= 4096);
+      read.insert(read.end(), data, data + size);
+    }
+    REQUIRE(source.error() == 0);
+    REQUIRE(read == bytes);
+  }
+
+  SECTION("partial value") {
+    bytes.pop_back();
+    write_file(path, bytes);
+    bit_converter::file_decoder<int32_t> decoder(path, true);
+    const int32_t *batch;
+    size_t count;
+    size_t total = 0;
+    while (decoder.next_batch(batch, count)) {
+      total += count;
+    }
+    REQUIRE(total == values.size() - 1);
+    REQUIRE(decoder.error() == EINVAL);
+  }
+
+  std::remove(path);
+
+  SECTION("missing file") {
+    int error = bit_converter::decode_file<int32_t>(
+        "/nonexistent/bit_converter", true, [](const int32_t *, size_t) {});
+    REQUIRE(error == ENOENT);
+  }
+}
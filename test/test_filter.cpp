@@ -0,0 +1,115 @@
+#include "bit_converter/bitmap.hpp"
+#include "bit_converter/filter.hpp"
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+using std::vector;
+
+using bit_converter::comparison;
+
+namespace {
+
+template <typename T> bool reference(const bit_converter::predicate<T> &where,
+                                     T value) {
+  switch (where.op) {
+  case comparison::less:
+    return value < where.value;
+  case comparison::less_equal:
+    return value <= where.value;
+  case comparison::equal:
+    return value == where.value;
+  case comparison::greater:
+    return value > where.value;
+  case comparison::greater_equal:
+    return value >= where.value;
+  default:
+    return value >= where.value && value <= where.upper;
+  }
+}
+
+template <typename T>
+void check_filter(const vector<T> &values, T low, T high) {
+  for (bool is_big_endian : {true, false}) {
+    vector<uint8_t> bytes;
+    bit_converter::values_to_bytes(values.data(), values.size(), is_big_endian,
+                                   std::back_inserter(bytes));
+    for (comparison op :
+         {comparison::less, comparison::less_equal, comparison::equal,
+          comparison::greater, comparison::greater_equal,
+          comparison::between}) {
+      bit_converter::predicate<T> where{op, low, high};
+      vector<bool> expected;
+      vector<uint32_t> expected_indices;
+      for (size_t i = 0; i < values.size(); i++) {
+        expected.push_back(reference(where, values[i]));
+        if (expected.back()) {
+          expected_indices.push_back(static_cast<uint32_t>(i));
+        }
+      }
+
+      // One byte past the bitmap must stay untouched.
+      vector<uint8_t> bitmap((values.size() + 7) / 8 + 1, 0xEE);
+      size_t matches = bit_converter::filter_to_bitmap(
+          bytes.data(), values.size(), is_big_endian, where, bitmap.data());
+      REQUIRE(matches == expected_indices.size());
+      REQUIRE(bitmap.back() == 0xEE);
+      REQUIRE(bit_converter::bytes_to_bits(bitmap.begin(), values.size(),
+                                           false) == expected);
+
+      vector<uint32_t> indices(values.size());
+      indices.resize(bit_converter::filter_to_indices(
+          bytes.data(), values.size(), is_big_endian, where, indices.data()));
+      REQUIRE(indices == expected_indices);
+
+      vector<size_t> wide_indices(values.size());
+      wide_indices.resize(bit_converter::filter_to_indices(
+          bytes.data(), values.size(), is_big_endian, where,
+          wide_indices.data()));
+      REQUIRE(std::equal(wide_indices.begin(), wide_indices.end(),
+                         expected_indices.begin(), expected_indices.end()));
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("test filter", "[filter]") {
+  SECTION("i32") {
+    vector<int32_t> values(203);
+    for (size_t i = 0; i < values.size(); i++) {
+      values[i] = static_cast<int32_t>(i * 37 % 101) - 50;
+    }
+    check_filter<int32_t>(values, -10, 20);
+    check_filter<int32_t>(values, 0, 0);
+  }
+
+  SECTION("i64") {
+    vector<int64_t> values(130);
+    for (size_t i = 0; i < values.size(); i++) {
+      values[i] = static_cast<int64_t>(i * 0x9E3779B97F4A7C15ULL) >> 3;
+    }
+    values[77] = 0;
+    check_filter<int64_t>(values, 0, int64_t(1) << 59);
+  }
+
+  SECTION("floating point") {
+    vector<double> doubles(150);
+    vector<float> floats(150);
+    for (size_t i = 0; i < doubles.size(); i++) {
+      doubles[i] = static_cast<double>(i % 23) * 0.5 - 3;
+      floats[i] = static_cast<float>(doubles[i]);
+    }
+    doubles[5] = std::numeric_limits<double>::quiet_NaN();
+    floats[70] = std::numeric_limits<float>::quiet_NaN();
+    check_filter<double>(doubles, -1, 2.5);
+    check_filter<float>(floats, 1.5f, 4);
+  }
+
+  SECTION("other types") {
+    check_filter<uint16_t>({1, 65535, 300, 2, 300}, 2, 300);
+    check_filter<int32_t>({}, 1, 2);
+  }
+}
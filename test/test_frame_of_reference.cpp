@@ -0,0 +1,63 @@
+#include "bit_converter/frame_of_reference.hpp"
+#include <catch2/catch.hpp>
+
+using std::vector;
+
+TEST_CASE("test frame of reference to bytes", "[frame_of_reference]") {
+  SECTION("header and packed residuals") {
+    vector<int32_t> values{-2, 1, 0, 5};
+    vector<uint8_t> bytes;
+    bit_converter::frame_of_reference_to_bytes(values.data(), values.size(),
+                                               true,
+                                               std::back_inserter(bytes));
+    // Minimum -2, residuals 0, 3, 2, 7 at three bits each.
+    REQUIRE(bytes == vector<uint8_t>{255, 255, 255, 255, 255, 255, 255, 254, 3,
+                                     0x98, 0x0E});
+  }
+  SECTION("constant block") {
+    vector<int64_t> values(200, 42);
+    vector<uint8_t> bytes;
+    bit_converter::frame_of_reference_to_bytes(values.data(), values.size(),
+                                               false,
+                                               std::back_inserter(bytes));
+    REQUIRE(bytes.size() == 2 * bit_converter::frame_of_reference_header_size);
+  }
+}
+
+TEST_CASE("test bytes to frame of reference", "[frame_of_reference]") {
+  SECTION("header and packed residuals") {
+    vector<uint8_t> bytes{255, 255, 255, 255, 255, 255, 255, 254, 3, 0x98, 0x0E};
+    vector<int32_t> values(4);
+    auto end = bit_converter::bytes_to_frame_of_reference(
+        bytes.begin(), values.size(), true, values.data());
+    REQUIRE(end == bytes.end());
+    REQUIRE(values == vector<int32_t>{-2, 1, 0, 5});
+  }
+}
+
+TEMPLATE_TEST_CASE("test frame of reference round trip", "[frame_of_reference]",
+                   int16_t, int32_t, uint32_t, int64_t, uint64_t) {
+  const size_t count = 1000;
+  for (int width = 0; width <= static_cast<int>(sizeof(TestType) * 8);
+       width++) {
+    vector<TestType> values(count);
+    uint64_t state = 12345;
+    for (size_t i = 0; i < count; i++) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      uint64_t residual = width == 64 ? state : state & ((1ULL << width) - 1);
+      values[i] = static_cast<TestType>(residual + 1000);
+    }
+    vector<uint8_t> bytes(
+        bit_converter::frame_of_reference_max_size<TestType>(count));
+    uint8_t *end = bit_converter::frame_of_reference_to_bytes(
+        values.data(), count, false, bytes.data());
+    REQUIRE(static_cast<size_t>(end - bytes.data()) <= bytes.size());
+
+    vector<TestType> decoded(count);
+    const uint8_t *read_end = bit_converter::bytes_to_frame_of_reference(
+        static_cast<const uint8_t *>(bytes.data()), count, false,
+        decoded.data());
+    REQUIRE(read_end == end);
+    REQUIRE(decoded == values);
+  }
+}
@@ -0,0 +1,109 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/gather.hpp"
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <iterator>
+
+using std::vector;
+
+namespace {
+
+template <typename T, typename Index> void check_gather() {
+  const size_t size = 1000;
+  vector<T> values(size);
+  for (size_t i = 0; i < size; i++) {
+    values[i] = static_cast<T>(i * 37 + 11);
+  }
+  vector<Index> indices;
+  for (size_t i = 0; i < 203; i++) {
+    indices.push_back(static_cast<Index>((i * 7919) % size));
+  }
+  for (bool is_big_endian : {true, false}) {
+    vector<uint8_t> bytes;
+    bit_converter::values_to_bytes(values.data(), size, is_big_endian,
+                                   std::back_inserter(bytes));
+
+    // Counts around the prefetch distance, with and without a prefetching
+    // part.
+    for (size_t count : {size_t(0), size_t(1), size_t(4), size_t(19),
+                         size_t(20), size_t(21), indices.size()}) {
+      vector<T> expected(count);
+      for (size_t i = 0; i < count; i++) {
+        expected[i] = values[indices[i]];
+      }
+      vector<T> result(count);
+      bit_converter::gather_values(bytes.data(), indices.data(), count,
+                                   is_big_endian, result.data());
+      REQUIRE(result == expected);
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("test gather_values", "[gather]") {
+  SECTION("16-bit values") {
+    check_gather<int16_t, uint32_t>();
+    check_gather<uint16_t, uint16_t>();
+  }
+
+  SECTION("32-bit values") {
+    check_gather<int32_t, uint32_t>();
+    check_gather<uint32_t, uint64_t>();
+    check_gather<float, uint32_t>();
+  }
+
+  SECTION("64-bit values") {
+    check_gather<int64_t, uint32_t>();
+    check_gather<uint64_t, uint64_t>();
+    check_gather<double, size_t>();
+  }
+
+  SECTION("matches bytes_to_u64 at each position") {
+    vector<uint8_t> bytes(64 * 8);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 29 + 3);
+    }
+    vector<uint32_t> indices = {63, 0, 5, 5, 17, 42, 1, 2, 3, 60, 30, 31};
+    vector<uint64_t> result(indices.size());
+    bit_converter::gather_values(bytes.data(), indices.data(), indices.size(),
+                                 true, result.data());
+    for (size_t i = 0; i < indices.size(); i++) {
+      REQUIRE(result[i] ==
+              bit_converter::bytes_to_u64(bytes.data() + indices[i] * 8, true));
+    }
+  }
+}
+
+TEST_CASE("test gather_at_offsets", "[gather]") {
+  vector<uint8_t> bytes(4096);
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<uint8_t>(i * 13 + 7);
+  }
+  // Unaligned offsets, as of records with a variable-length prefix.
+  vector<uint32_t> offsets;
+  for (size_t i = 0; i < 101; i++) {
+    offsets.push_back(
+        static_cast<uint32_t>((i * 577 + 3) % (bytes.size() - 8)));
+  }
+
+  for (bool is_big_endian : {true, false}) {
+    vector<int64_t> i64(offsets.size());
+    bit_converter::gather_at_offsets(bytes.data(), offsets.data(),
+                                     offsets.size(), is_big_endian, i64.data());
+    vector<float> f32(offsets.size());
+    bit_converter::gather_at_offsets(bytes.data(), offsets.data(),
+                                     offsets.size(), is_big_endian, f32.data());
+    vector<uint16_t> u16(offsets.size());
+    bit_converter::gather_at_offsets(bytes.data(), offsets.data(),
+                                     offsets.size(), is_big_endian, u16.data());
+    for (size_t i = 0; i < offsets.size(); i++) {
+      const uint8_t *at = bytes.data() + offsets[i];
+      REQUIRE(i64[i] == bit_converter::bytes_to_i64(at, is_big_endian));
+      float expected = bit_converter::bytes_to_f32(at, is_big_endian);
+      REQUIRE(std::memcmp(&f32[i], &expected, sizeof(float)) == 0);
+      REQUIRE(u16[i] == bit_converter::bytes_to_u16(at, is_big_endian));
+    }
+  }
+}
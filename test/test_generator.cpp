@@ -0,0 +1,103 @@
+#include "bit_converter/generator.hpp"
+#include <catch2/catch.hpp>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <cstdio>
+#include <iterator>
+
+using std::vector;
+
+TEST_CASE("test decode stream", "[generator]") {
+  vector<double> values(5000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<double>(i) * 0.75 - 100;
+  }
+  vector<uint8_t> bytes;
+  bit_converter::values_to_bytes(values.data(), values.size(), true,
+                                 std::back_inserter(bytes));
+
+  SECTION("buffer") {
+    auto stream = bit_converter::decode_stream<double>(bytes.data(),
+                                                       bytes.size(), true);
+    vector<double> decoded;
+    for (double v : stream) {
+      decoded.push_back(v);
+    }
+    REQUIRE(decoded == values);
+    REQUIRE(stream.error() == 0);
+  }
+
+  SECTION("empty buffer") {
+    auto stream = bit_converter::decode_stream<double>(bytes.data(), 0, true);
+    REQUIRE(stream.begin() == stream.end());
+    REQUIRE(stream.error() == 0);
+  }
+
+  SECTION("partial value") {
+    auto stream = bit_converter::decode_stream<double>(bytes.data(), 20, true);
+    vector<double> decoded;
+    for (double v : stream) {
+      decoded.push_back(v);
+    }
+    REQUIRE(decoded == vector<double>(values.begin(), values.begin() + 2));
+    REQUIRE(stream.error() == EINVAL);
+  }
+
+  SECTION("move") {
+    auto stream = bit_converter::decode_stream<double>(bytes.data(), 20, true);
+    auto moved = std::move(stream);
+    REQUIRE(stream.begin() == stream.end());
+    REQUIRE(stream.error() == 0);
+    vector<double> decoded;
+    for (double v : moved) {
+      decoded.push_back(v);
+    }
+    REQUIRE(decoded == vector<double>(values.begin(), values.begin() + 2));
+    REQUIRE(moved.error() == EINVAL);
+
+    auto other = bit_converter::decode_stream<double>(bytes.data(), 0, true);
+    other = std::move(moved);
+    REQUIRE(other.error() == EINVAL);
+  }
+
+  SECTION("reader") {
+    // Reads of 13 bytes split most values across two reads.
+    size_t offset = 0;
+    auto stream = bit_converter::decode_stream<double>(
+        [&](uint8_t *buffer, size_t capacity) {
+          size_t n = std::min({capacity, size_t(13), bytes.size() - offset});
+          std::copy(bytes.begin() + offset, bytes.begin() + offset + n, buffer);
+          offset += n;
+          return n;
+        },
+        true);
+    vector<double> decoded;
+    for (double v : stream) {
+      decoded.push_back(v);
+    }
+    REQUIRE(decoded == values);
+    REQUIRE(stream.error() == 0);
+  }
+
+  SECTION("file") {
+    char path[] = "/tmp/bit_converter_generator_XXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE(fd >= 0);
+    REQUIRE(::write(fd, bytes.data(), bytes.size()) ==
+            static_cast<ssize_t>(bytes.size()));
+    ::close(fd);
+    bit_converter::file_source::options config;
+    config.block_size = 4096;
+    auto stream = bit_converter::decode_file_stream<double>(path, true, config);
+    vector<double> decoded;
+    for (double v : stream) {
+      decoded.push_back(v);
+    }
+    REQUIRE(decoded == values);
+    REQUIRE(stream.error() == 0);
+    std::remove(path);
+  }
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include "bit_converter/gorilla.hpp"
+#include <catch2/catch.hpp>
+#include <limits>
+
+using std::vector;
+
+TEST_CASE("test f64 to gorilla", "[gorilla]") {
+  auto get_bytes = [](const vector<double> &values) -> vector<uint8_t> {
+    vector<uint8_t> bytes;
+    bit_converter::f64_to_gorilla(values.data(), values.size(),
+                                  std::back_inserter(bytes));
+    return bytes;
+  };
+  SECTION("repeated values") {
+    REQUIRE(get_bytes(vector<double>{1.0, 1.0, 1.0, 1.0}) ==
+            vector<uint8_t>{63, 240, 0, 0, 0, 0, 0, 0, 0});
+  }
+  SECTION("new window") {
+    // 1.0 ^ 1.5 has a single meaningful bit after 12 leading zeros.
+    REQUIRE(get_bytes(vector<double>{1.0, 1.5}) ==
+            vector<uint8_t>{63, 240, 0, 0, 0, 0, 0, 0, 0xD8, 0x0C});
+  }
+}
+
+TEST_CASE("test gorilla to f64", "[gorilla]") {
+  auto round_trip = [](const vector<double> &values) {
+    vector<uint8_t> bytes;
+    bit_converter::f64_to_gorilla(values.data(), values.size(),
+                                  std::back_inserter(bytes));
+    vector<double> decoded(values.size());
+    REQUIRE(bit_converter::gorilla_to_f64(bytes.data(), bytes.size(),
+                                          decoded.size(),
+                                          decoded.data()) == bytes.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      REQUIRE(std::memcmp(&decoded[i], &values[i], sizeof(double)) == 0);
+    }
+    return bytes.size();
+  };
+  SECTION("special values") {
+    round_trip(vector<double>{0.0, -0.0, std::numeric_limits<double>::infinity(),
+                              std::numeric_limits<double>::quiet_NaN(),
+                              std::numeric_limits<double>::denorm_min(),
+                              -std::numeric_limits<double>::max(), 1.0});
+  }
+  SECTION("sensor series") {
+    vector<double> values;
+    double temperature = 21.5;
+    for (int i = 0; i < 1000; i++) {
+      temperature += (i * 7919 % 7 == 0) ? 0.1 : 0.0;
+      values.push_back(temperature);
+    }
+    REQUIRE(round_trip(values) < values.size() * sizeof(double) / 4);
+  }
+}
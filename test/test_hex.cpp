@@ -0,0 +1,100 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/hex.hpp"
+#include "test_data.hpp"
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+using std::vector;
+
+namespace {
+
+/**
+ * @brief Format the bytes one at a time with `snprintf`.
+ */
+std::string reference_hex(const uint8_t *data, size_t size, char separator,
+                          bool is_upper_case) {
+  std::string hex;
+  for (size_t i = 0; i < size; i++) {
+    if (separator != '\0' && i != 0) {
+      hex += separator;
+    }
+    char digits[3];
+    std::snprintf(digits, sizeof digits, is_upper_case ? "%02X" : "%02x",
+                  data[i]);
+    hex += digits;
+  }
+  return hex;
+}
+
+} // namespace
+
+TEST_CASE("test hex", "[hex]") {
+  SECTION("matches BitConverter.ToString") {
+    const uint8_t bytes[] = {0x00, 0x0A, 0x1B, 0x7F, 0x80, 0xFF};
+    REQUIRE(bit_converter::to_hex_string(bytes, 6) == "00-0A-1B-7F-80-FF");
+    REQUIRE(bit_converter::to_hex_string(bytes, 6, '\0', false) ==
+            "000a1b7f80ff");
+    REQUIRE(bit_converter::to_hex_string(bytes, 1) == "00");
+    REQUIRE(bit_converter::to_hex_string(bytes, 0).empty());
+  }
+
+  SECTION("encodes and decodes every length") {
+    vector<uint8_t> bytes = test_data::make_bytes(300);
+    for (char separator : {'\0', '-', ':'}) {
+      for (bool is_upper_case : {true, false}) {
+        for (size_t size = 0; size <= bytes.size(); size++) {
+          std::string expected =
+              reference_hex(bytes.data(), size, separator, is_upper_case);
+          std::string hex(bit_converter::hex_size(size, separator), '?');
+          REQUIRE(hex.size() == expected.size());
+          char *end = bit_converter::bytes_to_hex(
+              bytes.data(), size, &hex[0], separator, is_upper_case);
+          REQUIRE(end == &hex[0] + hex.size());
+          REQUIRE(hex == expected);
+
+          REQUIRE(bit_converter::hex_decoded_size(hex.size(), separator) ==
+                  size);
+          vector<uint8_t> decoded(size);
+          REQUIRE(bit_converter::hex_to_bytes(hex.data(), hex.size(),
+                                              decoded.data(), separator));
+          REQUIRE(std::equal(decoded.begin(), decoded.end(), bytes.begin()));
+        }
+      }
+    }
+  }
+
+  SECTION("decodes mixed case") {
+    const std::string hex = "aBcDeF0123456789AbCdEf";
+    vector<uint8_t> decoded(hex.size() / 2);
+    REQUIRE(bit_converter::hex_to_bytes(hex.data(), hex.size(),
+                                        decoded.data()));
+    REQUIRE(decoded == vector<uint8_t>({0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45,
+                                        0x67, 0x89, 0xAB, 0xCD, 0xEF}));
+  }
+
+  SECTION("rejects malformed input") {
+    vector<uint8_t> bytes = test_data::make_bytes(100);
+    vector<uint8_t> decoded(bytes.size());
+    for (char separator : {'\0', '-'}) {
+      const std::string hex =
+          bit_converter::to_hex_string(bytes.data(), bytes.size(), separator);
+      REQUIRE_FALSE(bit_converter::hex_to_bytes(hex.data(), hex.size() - 1,
+                                                decoded.data(), separator));
+      // Every position, in every SIMD block and the scalar tail, is checked.
+      for (size_t i = 0; i < hex.size(); i++) {
+        for (char bad : {'g', 'G', '/', ':', '@', '`', ' ', '\0', '\x90'}) {
+          std::string corrupt = hex;
+          corrupt[i] = bad;
+          if (corrupt[i] == separator || bad == hex[i]) {
+            continue;
+          }
+          REQUIRE_FALSE(bit_converter::hex_to_bytes(
+              corrupt.data(), corrupt.size(), decoded.data(), separator));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,101 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/iovec_writer.hpp"
+#include <catch2/catch.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+using std::vector;
+
+namespace {
+
+vector<uint8_t> concatenate(bit_converter::iovec_writer &writer) {
+  vector<uint8_t> bytes;
+  for (const auto &v : writer.iovecs()) {
+    const uint8_t *base = static_cast<const uint8_t *>(v.iov_base);
+    bytes.insert(bytes.end(), base, base + v.iov_len);
+  }
+  return bytes;
+}
+
+} // namespace
+
+TEST_CASE("test iovec writer", "[iovec_writer]") {
+  vector<uint8_t> payload(1000);
+  for (size_t i = 0; i < payload.size(); i++) {
+    payload[i] = static_cast<uint8_t>(i);
+  }
+  bit_converter::iovec_writer writer;
+  writer.encode(4, [](uint8_t *output) {
+    bit_converter::u32_to_bytes(1000, true, output);
+  });
+  writer.write_value(static_cast<uint16_t>(7), false);
+  writer.write(payload.data(), payload.size());
+  writer.write("end", 3);
+
+  SECTION("segments") {
+    REQUIRE(writer.size() == 4 + 2 + 1000 + 3);
+    const auto &vectors = writer.iovecs();
+    REQUIRE(vectors.size() == 3);
+    REQUIRE(vectors[0].iov_len == 6);
+    REQUIRE(vectors[1].iov_base == payload.data());
+
+    vector<uint8_t> expected = payload;
+    expected.insert(expected.begin(), {0, 0, 3, 232, 7, 0});
+    expected.insert(expected.end(), {'e', 'n', 'd'});
+    REQUIRE(concatenate(writer) == expected);
+  }
+  SECTION("write to a file") {
+    std::FILE *file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    int fd = fileno(file);
+    REQUIRE(writer.write_to(fd) == static_cast<ssize_t>(writer.size()));
+    vector<uint8_t> bytes(writer.size());
+    REQUIRE(::pread(fd, bytes.data(), bytes.size(), 0) ==
+            static_cast<ssize_t>(bytes.size()));
+    REQUIRE(bytes == concatenate(writer));
+    std::fclose(file);
+  }
+  SECTION("resume on a non-blocking pipe") {
+    vector<uint8_t> large(200000);
+    for (size_t i = 0; i < large.size(); i++) {
+      large[i] = static_cast<uint8_t>(i * 7);
+    }
+    writer.write(large.data(), large.size());
+    vector<uint8_t> expected = concatenate(writer);
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    REQUIRE(::fcntl(fds[1], F_SETFL, O_NONBLOCK) == 0);
+    vector<uint8_t> received;
+    size_t offset = 0;
+    while (offset < writer.size()) {
+      ssize_t written = writer.write_to(fds[1], offset);
+      REQUIRE(written > 0);
+      offset += static_cast<size_t>(written);
+      if (offset < writer.size()) {
+        REQUIRE(errno == EAGAIN);
+        REQUIRE(writer.write_to(fds[1], offset) == -1);
+        REQUIRE(errno == EAGAIN);
+      }
+      vector<uint8_t> buffer(static_cast<size_t>(written));
+      size_t filled = 0;
+      while (filled < buffer.size()) {
+        ssize_t n = ::read(fds[0], buffer.data() + filled,
+                           buffer.size() - filled);
+        REQUIRE(n > 0);
+        filled += static_cast<size_t>(n);
+      }
+      received.insert(received.end(), buffer.begin(), buffer.end());
+    }
+    REQUIRE(received == expected);
+    ::close(fds[0]);
+    ::close(fds[1]);
+  }
+  SECTION("clear") {
+    writer.clear();
+    REQUIRE(writer.size() == 0);
+    REQUIRE(writer.iovecs().empty());
+  }
+}
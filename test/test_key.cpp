@@ -0,0 +1,150 @@
+#include "bit_converter/key.hpp"
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+using std::vector;
+
+namespace {
+
+template <typename T> vector<T> interesting_values() {
+  using limits = std::numeric_limits<T>;
+  vector<T> values = {limits::lowest(), limits::max(), T(0), T(1), T(100)};
+  if (std::is_signed<T>::value) {
+    values.push_back(static_cast<T>(-1));
+    values.push_back(static_cast<T>(-100));
+  }
+  if (std::is_floating_point<T>::value) {
+    values.push_back(limits::infinity());
+    values.push_back(-limits::infinity());
+    values.push_back(limits::min());
+    values.push_back(-limits::min());
+    values.push_back(limits::denorm_min());
+    values.push_back(-limits::denorm_min());
+    values.push_back(static_cast<T>(0.5));
+    values.push_back(static_cast<T>(-0.5));
+    values.push_back(static_cast<T>(1e10));
+    values.push_back(static_cast<T>(-1e10));
+  }
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (int i = 0; i < 500; i++) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    T value;
+    auto bits = static_cast<bit_converter::detail::uint_of_size<T>>(
+        state >> (64 - sizeof(T) * 8));
+    std::memcpy(&value, &bits, sizeof(T));
+    if (value == value) {
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+template <typename T> void check_keys() {
+  vector<T> values = interesting_values<T>();
+  vector<uint8_t> keys;
+  bit_converter::values_to_keys(values.data(), values.size(),
+                                std::back_inserter(keys));
+  REQUIRE(keys.size() == values.size() * sizeof(T));
+
+  // Keys compare like their values, with equal keys for equal values.
+  for (size_t i = 0; i < values.size(); i++) {
+    for (size_t j = i; j < std::min(values.size(), i + 40); j++) {
+      int order =
+          std::memcmp(&keys[i * sizeof(T)], &keys[j * sizeof(T)], sizeof(T));
+      if (values[i] < values[j]) {
+        REQUIRE(order < 0);
+      } else if (values[j] < values[i]) {
+        REQUIRE(order > 0);
+      } else if (std::memcmp(&values[i], &values[j], sizeof(T)) == 0) {
+        REQUIRE(order == 0);
+      }
+    }
+  }
+
+  // Sorting the keys sorts the values.
+  vector<vector<uint8_t>> sorted;
+  for (size_t i = 0; i < values.size(); i++) {
+    sorted.emplace_back(keys.begin() + i * sizeof(T),
+                        keys.begin() + (i + 1) * sizeof(T));
+  }
+  std::sort(sorted.begin(), sorted.end());
+  vector<T> decoded;
+  for (const auto &key : sorted) {
+    decoded.push_back(bit_converter::key_to_value<T>(key.begin()));
+  }
+  REQUIRE(std::is_sorted(decoded.begin(), decoded.end()));
+
+  // The keys decode to the same bits.
+  vector<T> round_trip(values.size());
+  REQUIRE(bit_converter::keys_to_values(keys.data(), values.size(),
+                                        round_trip.data()) ==
+          keys.data() + keys.size());
+  REQUIRE(std::memcmp(round_trip.data(), values.data(),
+                      values.size() * sizeof(T)) == 0);
+
+  uint8_t single[sizeof(T)];
+  for (size_t i = 0; i < values.size(); i++) {
+    REQUIRE(bit_converter::value_to_key(values[i], single) ==
+            single + sizeof(T));
+    REQUIRE(std::memcmp(single, &keys[i * sizeof(T)], sizeof(T)) == 0);
+  }
+}
+
+} // namespace
+
+TEST_CASE("test value_to_key", "[key]") {
+  SECTION("integers") {
+    check_keys<int8_t>();
+    check_keys<uint8_t>();
+    check_keys<int16_t>();
+    check_keys<uint16_t>();
+    check_keys<int32_t>();
+    check_keys<uint32_t>();
+    check_keys<int64_t>();
+    check_keys<uint64_t>();
+  }
+
+  SECTION("floating point") {
+    check_keys<float>();
+    check_keys<double>();
+  }
+
+  SECTION("known keys") {
+    uint8_t key[8];
+    bit_converter::value_to_key(int64_t(-1), key);
+    REQUIRE(vector<uint8_t>(key, key + 8) ==
+            vector<uint8_t>{0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF});
+    bit_converter::value_to_key(int64_t(0), key);
+    REQUIRE(vector<uint8_t>(key, key + 8) ==
+            vector<uint8_t>{0x80, 0, 0, 0, 0, 0, 0, 0});
+    bit_converter::value_to_key(1.0, key);
+    REQUIRE(vector<uint8_t>(key, key + 8) ==
+            vector<uint8_t>{0xBF, 0xF0, 0, 0, 0, 0, 0, 0});
+    bit_converter::value_to_key(-1.0, key);
+    REQUIRE(vector<uint8_t>(key, key + 8) ==
+            vector<uint8_t>{0x40, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF});
+  }
+
+  SECTION("total order of zeros and NaNs") {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    vector<float> values = {-nan, -std::numeric_limits<float>::infinity(),
+                            -0.0f, 0.0f, std::numeric_limits<float>::infinity(),
+                            nan};
+    vector<uint8_t> keys(values.size() * 4);
+    bit_converter::values_to_keys(values.data(), values.size(), keys.data());
+    for (size_t i = 0; i + 1 < values.size(); i++) {
+      REQUIRE(std::memcmp(&keys[i * 4], &keys[(i + 1) * 4], 4) < 0);
+    }
+    vector<float> decoded(values.size());
+    bit_converter::keys_to_values(keys.data(), values.size(), decoded.data());
+    REQUIRE(std::signbit(decoded[2]));
+    REQUIRE(!std::signbit(decoded[3]));
+    REQUIRE(std::isnan(decoded[0]));
+    REQUIRE(std::isnan(decoded[5]));
+  }
+}
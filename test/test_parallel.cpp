@@ -0,0 +1,39 @@
+#include "bit_converter/parallel.hpp"
+#include <catch2/catch.hpp>
+
+using std::vector;
+
+TEST_CASE("test thread pool", "[parallel]") {
+  bit_converter::thread_pool pool(4);
+  REQUIRE(pool.size() == 4);
+  for (int round = 0; round < 10; round++) {
+    vector<std::atomic<int>> counts(1000);
+    pool.parallel_for(counts.size(), [&](size_t i) { counts[i]++; });
+    for (auto &count : counts) {
+      REQUIRE(count == 1);
+    }
+  }
+}
+
+TEST_CASE("test parallel bulk conversion", "[parallel]") {
+  bit_converter::thread_pool pool(4);
+  for (size_t count : {size_t(1000), size_t(3) << 20}) {
+    vector<int64_t> values(count);
+    for (size_t i = 0; i < count; i++) {
+      values[i] = static_cast<int64_t>(i * 0x9E3779B97F4A7C15ULL);
+    }
+    vector<uint8_t> expected(count * sizeof(int64_t));
+    bit_converter::values_to_bytes(values.data(), count, true,
+                                   expected.data());
+    vector<uint8_t> bytes(expected.size());
+    bit_converter::values_to_bytes(values.data(), count, true, bytes.data(),
+                                   pool);
+    REQUIRE(bytes == expected);
+
+    vector<int64_t> decoded(count);
+    bit_converter::bytes_to_values(
+        static_cast<const uint8_t *>(bytes.data()), count, true,
+        decoded.data(), pool);
+    REQUIRE(decoded == values);
+  }
+}
@@ -0,0 +1,173 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/pcm.hpp"
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <limits>
+
+using std::vector;
+
+using bit_converter::pcm_format;
+
+namespace {
+
+int32_t reference_sample(const uint8_t *input, pcm_format format,
+                         bool is_big_endian) {
+  if (format == pcm_format::s16) {
+    return bit_converter::bytes_to_i16(input, is_big_endian);
+  }
+  // Place the sample in the top three bytes and shift its sign down.
+  uint8_t bytes[4] = {0, 0, 0, 0};
+  for (int i = 0; i < 3; i++) {
+    bytes[is_big_endian ? i : i + 1] = input[i];
+  }
+  return bit_converter::bytes_to_i32(bytes, is_big_endian) >> 8;
+}
+
+vector<uint8_t> make_samples(size_t count, pcm_format format) {
+  vector<uint8_t> bytes(count * bit_converter::pcm_sample_size(format));
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<uint8_t>(i * 151 + (i >> 7));
+  }
+  return bytes;
+}
+
+template <typename F> void for_each_format(F &&f) {
+  for (pcm_format format : {pcm_format::s16, pcm_format::s24}) {
+    for (bool is_big_endian : {true, false}) {
+      f(format, is_big_endian, bit_converter::pcm_sample_size(format),
+        format == pcm_format::s16 ? 32768.0f : 8388608.0f);
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("test pcm_to_float", "[pcm]") {
+  SECTION("interleaved") {
+    for_each_format([](pcm_format format, bool is_big_endian, size_t size,
+                       float scale) {
+      for (size_t count : {0, 1, 7, 8, 9, 10, 17, 100, 1001}) {
+        vector<uint8_t> bytes = make_samples(count, format);
+        vector<float> result(count);
+        bit_converter::pcm_to_float(bytes.data(), count, format,
+                                    is_big_endian, result.data());
+        for (size_t i = 0; i < count; i++) {
+          REQUIRE(result[i] ==
+                  static_cast<float>(reference_sample(
+                      bytes.data() + i * size, format, is_big_endian)) /
+                      scale);
+        }
+      }
+    });
+  }
+
+  SECTION("de-interleaved") {
+    for_each_format([](pcm_format format, bool is_big_endian, size_t size,
+                       float scale) {
+      for (size_t channels : {1, 2, 3, 6}) {
+        for (size_t frames : {0, 1, 8, 9, 15, 16, 333}) {
+          vector<uint8_t> bytes = make_samples(frames * channels, format);
+          vector<vector<float>> planes(channels, vector<float>(frames));
+          vector<float *> pointers;
+          for (auto &plane : planes) {
+            pointers.push_back(plane.data());
+          }
+          bit_converter::pcm_to_float_planes(bytes.data(), frames, channels,
+                                             format, is_big_endian,
+                                             pointers.data());
+          for (size_t frame = 0; frame < frames; frame++) {
+            for (size_t channel = 0; channel < channels; channel++) {
+              const uint8_t *sample =
+                  bytes.data() + (frame * channels + channel) * size;
+              REQUIRE(planes[channel][frame] ==
+                      static_cast<float>(reference_sample(sample, format,
+                                                          is_big_endian)) /
+                          scale);
+            }
+          }
+        }
+      }
+    });
+  }
+
+  SECTION("known values") {
+    const uint8_t s16[] = {0x00, 0x80, 0xFF, 0x7F, 0x00, 0x40, 0xFF, 0xFF};
+    float result[4];
+    bit_converter::pcm_to_float(s16, 4, pcm_format::s16, false, result);
+    REQUIRE(result[0] == -1.0f);
+    REQUIRE(result[1] == 32767.0f / 32768.0f);
+    REQUIRE(result[2] == 0.5f);
+    REQUIRE(result[3] == -1.0f / 32768.0f);
+
+    const uint8_t s24[] = {0x80, 0x00, 0x00, 0x40, 0x00, 0x00,
+                           0xFF, 0xFF, 0xFF, 0x7F, 0xFF, 0xFF};
+    bit_converter::pcm_to_float(s24, 4, pcm_format::s24, true, result);
+    REQUIRE(result[0] == -1.0f);
+    REQUIRE(result[1] == 0.5f);
+    REQUIRE(result[2] == -1.0f / 8388608.0f);
+    REQUIRE(result[3] == 8388607.0f / 8388608.0f);
+  }
+}
+
+TEST_CASE("test float_to_pcm", "[pcm]") {
+  SECTION("rounds and saturates") {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    vector<float> values = {0.0f,  1.0f,   -1.0f,         2.0f,
+                            -2.0f, inf,    -inf,          nan,
+                            0.5f,  -0.5f,  1.5f / 32768,  2.5f / 32768,
+                            -0.0f, 0.25f,  -1.5f / 32768, 0.999f};
+    // Ties round to even.
+    vector<int32_t> expected16 = {0,     32767,  -32768, 32767,
+                                  -32768, 32767, -32768, 0,
+                                  16384, -16384, 2,      2,
+                                  0,     8192,   -2,     32735};
+    for (bool is_big_endian : {true, false}) {
+      vector<uint8_t> bytes(values.size() * 2);
+      bit_converter::float_to_pcm(values.data(), values.size(), pcm_format::s16,
+                                  is_big_endian, bytes.data());
+      for (size_t i = 0; i < values.size(); i++) {
+        REQUIRE(bit_converter::bytes_to_i16(bytes.data() + i * 2,
+                                            is_big_endian) == expected16[i]);
+      }
+    }
+
+    vector<uint8_t> bytes(values.size() * 3);
+    bit_converter::float_to_pcm(values.data(), values.size(), pcm_format::s24,
+                                true, bytes.data());
+    REQUIRE(reference_sample(&bytes[1 * 3], pcm_format::s24, true) == 8388607);
+    REQUIRE(reference_sample(&bytes[2 * 3], pcm_format::s24, true) ==
+            -8388608);
+    REQUIRE(reference_sample(&bytes[7 * 3], pcm_format::s24, true) == 0);
+    REQUIRE(reference_sample(&bytes[8 * 3], pcm_format::s24, true) == 4194304);
+  }
+
+  SECTION("round trips through floats") {
+    for_each_format([](pcm_format format, bool is_big_endian, size_t,
+                       float) {
+      for (size_t channels : {1, 2, 5}) {
+        const size_t frames = 517;
+        vector<uint8_t> bytes = make_samples(frames * channels, format);
+        vector<vector<float>> planes(channels, vector<float>(frames));
+        vector<float *> pointers;
+        vector<const float *> const_pointers;
+        for (auto &plane : planes) {
+          pointers.push_back(plane.data());
+          const_pointers.push_back(plane.data());
+        }
+        bit_converter::pcm_to_float_planes(bytes.data(), frames, channels,
+                                           format, is_big_endian,
+                                           pointers.data());
+        // One byte past the output must stay untouched.
+        vector<uint8_t> encoded(bytes.size() + 1, 0xEE);
+        bit_converter::float_planes_to_pcm(const_pointers.data(), frames,
+                                           channels, format, is_big_endian,
+                                           encoded.data());
+        REQUIRE(encoded.back() == 0xEE);
+        encoded.pop_back();
+        REQUIRE(encoded == bytes);
+      }
+    });
+  }
+}
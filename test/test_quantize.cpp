@@ -0,0 +1,105 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/quantize.hpp"
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <limits>
+
+using std::vector;
+
+namespace {
+
+template <typename Q>
+int64_t read_quantized(const uint8_t *input, bool is_big_endian) {
+  Q value;
+  bit_converter::bytes_to_values(input, 1, is_big_endian, &value);
+  return value;
+}
+
+/**
+ * @brief The expected result, computed in double with explicit bounds.
+ */
+template <typename Q, typename F>
+int64_t reference(F value, F scale, F offset) {
+  F scaled = value * scale + offset;
+  if (std::isnan(scaled)) {
+    return 0;
+  }
+  double rounded = std::nearbyint(static_cast<double>(scaled));
+  rounded = std::max(rounded,
+                     static_cast<double>(std::numeric_limits<Q>::min()));
+  rounded = std::min(rounded,
+                     static_cast<double>(std::numeric_limits<Q>::max()));
+  return static_cast<int64_t>(rounded);
+}
+
+template <typename Q, typename F> void check_quantize(F scale, F offset) {
+  const F nan = std::numeric_limits<F>::quiet_NaN();
+  const F inf = std::numeric_limits<F>::infinity();
+  const F big = static_cast<F>(std::numeric_limits<Q>::max());
+  vector<F> values = {0,       1,        -1,      F(0.5),  F(-0.5),
+                      F(1.5),  F(2.5),   F(-2.5), nan,     inf,
+                      -inf,    big,      -big,    big * 2, -big * 2,
+                      F(1e30), F(-1e30), F(0.25), F(-0.75), F(3.49)};
+  for (int i = 0; i < 83; i++) {
+    values.push_back(static_cast<F>(std::sin(i) * 1.3));
+  }
+  for (bool is_big_endian : {true, false}) {
+    bit_converter::quantization<F> params{scale, offset};
+    // One byte past the output must stay untouched.
+    vector<uint8_t> bytes(values.size() * sizeof(Q) + 1, 0xEE);
+    uint8_t *end = bit_converter::quantize_to_bytes<Q>(
+        values.data(), values.size(), is_big_endian, params, bytes.data());
+    REQUIRE(end == bytes.data() + values.size() * sizeof(Q));
+    REQUIRE(bytes.back() == 0xEE);
+    for (size_t i = 0; i < values.size(); i++) {
+      REQUIRE(read_quantized<Q>(bytes.data() + i * sizeof(Q),
+                                is_big_endian) ==
+              reference<Q>(values[i], scale, offset));
+    }
+
+    vector<F> decoded(values.size());
+    const uint8_t *input_end = bit_converter::dequantize_bytes<Q>(
+        bytes.data(), values.size(), is_big_endian, params, decoded.data());
+    REQUIRE(input_end == end);
+    for (size_t i = 0; i < values.size(); i++) {
+      F q = static_cast<F>(
+          read_quantized<Q>(bytes.data() + i * sizeof(Q), is_big_endian));
+      REQUIRE(decoded[i] == (q - offset) * (1 / scale));
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("test quantize_to_bytes", "[quantize]") {
+  SECTION("float") {
+    check_quantize<int8_t, float>(100.0f, 0.0f);
+    check_quantize<uint8_t, float>(100.0f, 128.0f);
+    check_quantize<int16_t, float>(30000.0f, -5.0f);
+    check_quantize<uint16_t, float>(30000.0f, 32768.0f);
+    check_quantize<int32_t, float>(1e9f, 0.0f);
+    check_quantize<uint32_t, float>(1e9f, 2e9f);
+  }
+
+  SECTION("double") {
+    check_quantize<int8_t, double>(100.0, 3.0);
+    check_quantize<uint8_t, double>(127.5, 127.5);
+    check_quantize<int16_t, double>(32767.0, 0.0);
+    check_quantize<uint16_t, double>(1000.0, 0.0);
+    check_quantize<int32_t, double>(2e9, 0.0);
+    check_quantize<uint32_t, double>(2e9, 2e9);
+  }
+
+  SECTION("known values") {
+    const float values[] = {0.1f, -0.1f, 1.0f, -1.0f};
+    uint8_t bytes[8];
+    bit_converter::quantize_to_bytes<int16_t>(
+        values, 4, true, bit_converter::quantization<float>{1000.0f, 0.0f},
+        bytes);
+    REQUIRE(bit_converter::bytes_to_i16(bytes, true) == 100);
+    REQUIRE(bit_converter::bytes_to_i16(bytes + 2, true) == -100);
+    REQUIRE(bit_converter::bytes_to_i16(bytes + 4, true) == 1000);
+    REQUIRE(bit_converter::bytes_to_i16(bytes + 6, true) == -1000);
+  }
+}
@@ -0,0 +1,145 @@
+#include "bit_converter/radix_sort.hpp"
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+using std::vector;
+
+namespace {
+
+/**
+ * @brief Sort records with `std::stable_sort` on their key bytes.
+ */
+vector<uint8_t> reference_sort(const vector<uint8_t> &records,
+                               size_t record_size, size_t key_size) {
+  size_t count = records.size() / record_size;
+  vector<size_t> order(count);
+  for (size_t i = 0; i < count; i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return std::memcmp(&records[a * record_size], &records[b * record_size],
+                       key_size) < 0;
+  });
+  vector<uint8_t> sorted;
+  for (size_t i : order) {
+    sorted.insert(sorted.end(), records.begin() + i * record_size,
+                  records.begin() + (i + 1) * record_size);
+  }
+  return sorted;
+}
+
+void check_sort(vector<uint8_t> records, size_t record_size,
+                size_t key_size) {
+  vector<uint8_t> expected = reference_sort(records, record_size, key_size);
+  vector<uint8_t> scratch(records.size());
+  bit_converter::radix_sort_records(records.data(),
+                                    records.size() / record_size, record_size,
+                                    key_size, scratch.data());
+  REQUIRE(records == expected);
+}
+
+/**
+ * @brief Records of a key written by `value_to_key` followed by the
+ * position of the record as its payload.
+ */
+template <typename T>
+vector<uint8_t> make_records(const vector<T> &values, size_t &record_size) {
+  record_size = sizeof(T) + 4;
+  vector<uint8_t> records;
+  for (size_t i = 0; i < values.size(); i++) {
+    bit_converter::value_to_key(values[i], std::back_inserter(records));
+    uint32_t position = static_cast<uint32_t>(i);
+    bit_converter::values_to_bytes(&position, 1, true,
+                                   std::back_inserter(records));
+  }
+  return records;
+}
+
+uint64_t next_random(uint64_t &state) {
+  state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return state >> 11;
+}
+
+} // namespace
+
+TEST_CASE("test radix_sort_records", "[radix_sort]") {
+  uint64_t state = 42;
+
+  SECTION("keys from value_to_key sort like their values") {
+    vector<int64_t> values;
+    for (int i = 0; i < 3000; i++) {
+      values.push_back(static_cast<int64_t>(next_random(state)) - (1LL << 52));
+    }
+    size_t record_size;
+    vector<uint8_t> records = make_records(values, record_size);
+    vector<uint8_t> scratch(records.size());
+    bit_converter::radix_sort_records(records.data(), values.size(),
+                                      record_size, 8, scratch.data());
+    vector<int64_t> sorted;
+    for (size_t i = 0; i < values.size(); i++) {
+      sorted.push_back(
+          bit_converter::key_to_value<int64_t>(&records[i * record_size]));
+    }
+    std::sort(values.begin(), values.end());
+    REQUIRE(sorted == values);
+  }
+
+  SECTION("floating-point keys") {
+    vector<double> values;
+    for (int i = 0; i < 2000; i++) {
+      values.push_back((static_cast<double>(next_random(state)) - 1e15) /
+                       (1 + static_cast<double>(next_random(state) % 1000)));
+    }
+    size_t record_size;
+    vector<uint8_t> records = make_records(values, record_size);
+    check_sort(records, record_size, 8);
+  }
+
+  SECTION("2, 4, 8 and 16-byte keys with payloads") {
+    for (size_t key_size : {2, 4, 8, 16}) {
+      for (size_t payload : {0, 1, 4, 8, 13}) {
+        const size_t record_size = key_size + payload;
+        vector<uint8_t> records(1500 * record_size);
+        for (uint8_t &byte : records) {
+          byte = static_cast<uint8_t>(next_random(state));
+        }
+        check_sort(records, record_size, key_size);
+      }
+    }
+  }
+
+  SECTION("constant and duplicate digits") {
+    // Small values leave the high bytes constant, and many keys repeat, so
+    // stability shows in the payloads.
+    vector<int32_t> values;
+    for (int i = 0; i < 5000; i++) {
+      values.push_back(static_cast<int32_t>(next_random(state) % 300));
+    }
+    size_t record_size;
+    vector<uint8_t> records = make_records(values, record_size);
+    check_sort(records, record_size, 4);
+
+    vector<int32_t> same(100, 7);
+    records = make_records(same, record_size);
+    check_sort(records, record_size, 4);
+  }
+
+  SECTION("empty and single records") {
+    check_sort({}, 8, 8);
+    check_sort({1, 2, 3, 4, 5, 6, 7, 8}, 8, 8);
+  }
+
+  SECTION("keys only") {
+    vector<uint8_t> keys(999 * 4);
+    for (uint8_t &byte : keys) {
+      byte = static_cast<uint8_t>(next_random(state));
+    }
+    vector<uint8_t> expected = reference_sort(keys, 4, 4);
+    vector<uint8_t> scratch(keys.size());
+    bit_converter::radix_sort_keys(keys.data(), 999, 4, scratch.data());
+    REQUIRE(keys == expected);
+  }
+}
@@ -0,0 +1,77 @@
+#include "bit_converter/reduce.hpp"
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+using std::vector;
+
+namespace {
+
+template <typename T> void check_reduction(const vector<T> &values) {
+  for (bool is_big_endian : {true, false}) {
+    vector<uint8_t> bytes;
+    bit_converter::values_to_bytes(values.data(), values.size(), is_big_endian,
+                                   std::back_inserter(bytes));
+    auto result = bit_converter::reduce_bytes<T>(bytes.data(), values.size(),
+                                                 is_big_endian);
+    bit_converter::reduction_sum_t<T> sum = 0;
+    for (T value : values) {
+      sum = bit_converter::detail::add_wrapping(sum, value);
+    }
+    REQUIRE(result.count == values.size());
+    REQUIRE(result.sum == sum);
+    REQUIRE(result.min == *std::min_element(values.begin(), values.end()));
+    REQUIRE(result.max == *std::max_element(values.begin(), values.end()));
+  }
+}
+
+} // namespace
+
+TEST_CASE("test reduce bytes", "[reduce]") {
+  SECTION("i64") {
+    vector<int64_t> values(1003);
+    for (size_t i = 0; i < values.size(); i++) {
+      values[i] = static_cast<int64_t>(i * 0x9E3779B97F4A7C15ULL);
+    }
+    check_reduction(values);
+    check_reduction(vector<int64_t>{-5, 3});
+  }
+
+  SECTION("f64") {
+    // Whole numbers, so that the sum is exact in any order.
+    vector<double> values(517);
+    for (size_t i = 0; i < values.size(); i++) {
+      values[i] = static_cast<double>((i * 7919) % 1000) - 500;
+    }
+    check_reduction(values);
+  }
+
+  SECTION("other types") {
+    check_reduction(vector<int32_t>{7, -2147483647 - 1, 2147483647, 0});
+    check_reduction(vector<uint16_t>{7, 65535, 0, 12});
+    check_reduction(vector<float>{1.5f, -2.25f, 100.0f});
+  }
+
+  SECTION("NaN") {
+    vector<double> values(20, 1.0);
+    values[3] = -4;
+    values[11] = std::numeric_limits<double>::quiet_NaN();
+    values[17] = 9;
+    vector<uint8_t> bytes;
+    bit_converter::values_to_bytes(values.data(), values.size(), true,
+                                   std::back_inserter(bytes));
+    auto result = bit_converter::reduce_bytes<double>(bytes.data(), 20, true);
+    REQUIRE(std::isnan(result.sum));
+    REQUIRE(result.min == -4);
+    REQUIRE(result.max == 9);
+  }
+
+  SECTION("empty") {
+    auto result = bit_converter::reduce_bytes<int64_t>(nullptr, 0, true);
+    REQUIRE(result.count == 0);
+    REQUIRE(result.sum == 0);
+    REQUIRE(result.min > result.max);
+  }
+}
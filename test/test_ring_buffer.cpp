@@ -0,0 +1,100 @@
+#include "bit_converter/ring_buffer.hpp"
+#include <catch2/catch.hpp>
+
+#include <iterator>
+#include <thread>
+
+using std::vector;
+
+TEST_CASE("test spsc ring", "[ring_buffer]") {
+  bit_converter::spsc_ring ring(100);
+  REQUIRE(ring.capacity() == 128);
+
+  SECTION("wraparound") {
+    vector<uint8_t> bytes(100);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i);
+    }
+    REQUIRE(ring.write(bytes.data(), 100) == 100);
+    REQUIRE(ring.write(bytes.data(), 100) == 28);
+    vector<uint8_t> read(100);
+    REQUIRE(ring.read(read.data(), 100) == 100);
+    REQUIRE(read == bytes);
+    REQUIRE(ring.write(bytes.data() + 28, 72) == 72);
+    REQUIRE(ring.readable() == 100);
+    size_t size;
+    ring.read_region(0, size);
+    REQUIRE(size == 28);
+    ring.read_region(28, size);
+    REQUIRE(size == 72);
+    REQUIRE(ring.read(read.data(), 100) == 100);
+    REQUIRE(read == bytes);
+
+    uint8_t *region = ring.write_region(size);
+    REQUIRE(size == 56);
+    region[0] = 42;
+    ring.publish(1);
+    REQUIRE(ring.read(read.data(), 100) == 1);
+    REQUIRE(read[0] == 42);
+  }
+
+  SECTION("decode across the end") {
+    vector<uint32_t> values = {0x01020304, 0x05060708, 0x090a0b0c};
+    vector<uint8_t> bytes;
+    bit_converter::values_to_bytes(values.data(), values.size(), true,
+                                   std::back_inserter(bytes));
+    vector<uint8_t> padding(126);
+    ring.write(padding.data(), padding.size());
+    ring.read(padding.data(), padding.size());
+    REQUIRE(ring.write(bytes.data(), bytes.size()) == bytes.size());
+    uint32_t decoded[4];
+    REQUIRE(bit_converter::decode_from_ring(ring, true, decoded, 4) == 3);
+    REQUIRE(vector<uint32_t>(decoded, decoded + 3) == values);
+    REQUIRE(ring.readable() == 0);
+  }
+}
+
+TEST_CASE("test spsc ring between threads", "[ring_buffer]") {
+  const uint64_t count = 200000;
+  bit_converter::spsc_ring ring(1000);
+  std::thread producer([&] {
+    uint64_t next = 0;
+    while (next < count) {
+      size_t n = std::min<uint64_t>(count - next, 37);
+      vector<uint64_t> values(n);
+      for (size_t i = 0; i < n; i++) {
+        values[i] = next + i;
+      }
+      vector<uint8_t> bytes;
+      bit_converter::values_to_bytes(values.data(), n, true,
+                                     std::back_inserter(bytes));
+      // Write odd sizes so that values straddle the end of the ring.
+      size_t written = 0;
+      while (written < bytes.size()) {
+        size_t size = ring.write(bytes.data() + written,
+                                 std::min<size_t>(bytes.size() - written, 13));
+        if (size == 0) {
+          std::this_thread::yield();
+        }
+        written += size;
+      }
+      next += n;
+    }
+  });
+  uint64_t expected = 0;
+  bool is_ordered = true;
+  uint64_t decoded[64];
+  while (expected < count) {
+    size_t n = bit_converter::decode_from_ring(ring, true, decoded, 64);
+    if (n == 0) {
+      std::this_thread::yield();
+    }
+    for (size_t i = 0; i < n; i++) {
+      is_ordered = is_ordered && decoded[i] == expected + i;
+    }
+    expected += n;
+  }
+  producer.join();
+  REQUIRE(is_ordered);
+  REQUIRE(expected == count);
+}
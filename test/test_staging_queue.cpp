@@ -0,0 +1,69 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/staging_queue.hpp"
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+using std::vector;
+
+TEST_CASE("test mpsc staging queue", "[staging_queue]") {
+  SECTION("order") {
+    bit_converter::mpsc_staging_queue queue(256);
+    auto first = queue.reserve(4);
+    auto second = queue.reserve(3);
+    bit_converter::u32_to_bytes(7, true, second.data);
+    queue.commit(second);
+    vector<size_t> sizes;
+    auto on_record = [&](const uint8_t *, size_t size) {
+      sizes.push_back(size);
+    };
+    // The second record waits for the first one.
+    REQUIRE(queue.drain(on_record) == 0);
+    queue.commit(first);
+    REQUIRE(queue.drain(on_record) == 2);
+    REQUIRE(sizes == vector<size_t>{4, 3});
+  }
+
+  SECTION("producers") {
+    const size_t producer_count = 4;
+    const uint32_t record_count = 20000;
+    bit_converter::mpsc_staging_queue queue(1024);
+    vector<std::thread> producers;
+    for (size_t p = 0; p < producer_count; p++) {
+      producers.emplace_back([&, p] {
+        for (uint32_t i = 0; i < record_count; i++) {
+          // Records of varying length wrap around the ring at many offsets.
+          queue.encode(12 + i % 5, [&](uint8_t *output) {
+            output = bit_converter::u32_to_bytes(static_cast<uint32_t>(p),
+                                                 true, output);
+            output = bit_converter::i64_to_bytes(i, true, output);
+            std::fill(output, output + i % 5, uint8_t(0xAB));
+          });
+        }
+      });
+    }
+    vector<uint32_t> next(producer_count, 0);
+    bool is_valid = true;
+    size_t total = 0;
+    while (total < producer_count * record_count) {
+      size_t n = queue.drain([&](const uint8_t *data, size_t size) {
+        uint32_t p = bit_converter::bytes_to_u32(data, true);
+        int64_t i = bit_converter::bytes_to_i64(data + 4, true);
+        is_valid = is_valid && p < producer_count && i == next[p] &&
+                   size == 12 + next[p] % 5;
+        if (p < producer_count) {
+          next[p]++;
+        }
+      });
+      if (n == 0) {
+        std::this_thread::yield();
+      }
+      total += n;
+    }
+    for (auto &producer : producers) {
+      producer.join();
+    }
+    REQUIRE(is_valid);
+    REQUIRE(total == producer_count * record_count);
+  }
+}
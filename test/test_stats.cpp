@@ -0,0 +1,73 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/bulk.hpp"
+#include "bit_converter/stats.hpp"
+#include <catch2/catch.hpp>
+
+#include <iterator>
+#include <thread>
+
+using std::vector;
+
+using bit_converter::stats_function;
+using bit_converter::stats_path;
+
+TEST_CASE("test stats", "[stats]") {
+  auto before = bit_converter::collect_stats();
+
+  vector<uint8_t> bytes(64);
+  vector<uint8_t> appended;
+  bit_converter::u32_to_bytes(1, true, bytes.data());
+  bit_converter::u32_to_bytes(2, true, std::back_inserter(appended));
+  bit_converter::bytes_to_f64(bytes.data(), false);
+  uint16_t values[4] = {1, 2, 3, 4};
+  bit_converter::values_to_bytes(values, 4, true, bytes.data());
+  bit_converter::values_to_bytes(values, 4, false, bytes.data());
+  std::thread([&] {
+    vector<uint8_t> local(8);
+    bit_converter::i64_to_bytes(-1, true, local.data());
+  }).join();
+
+  auto after = bit_converter::collect_stats();
+  auto delta = [&](stats_function function) {
+    bit_converter::function_stats result = after[function];
+    result.calls -= before[function].calls;
+    result.values -= before[function].values;
+    result.bytes -= before[function].bytes;
+    for (size_t p = 0; p < bit_converter::stats_path_count; p++) {
+      result.paths[p] -= before[function].paths[p];
+    }
+    return result;
+  };
+  auto path = [](stats_path p) { return static_cast<size_t>(p); };
+
+  REQUIRE(std::string(bit_converter::stats_function_name(
+              stats_function::bytes_to_values)) == "bytes_to_values");
+  REQUIRE(std::string(bit_converter::stats_path_name(stats_path::bulk_swap)) ==
+          "bulk_swap");
+
+  if (!bit_converter::is_stats_enabled) {
+    REQUIRE(after[stats_function::u32_to_bytes].calls == 0);
+    return;
+  }
+
+  auto u32 = delta(stats_function::u32_to_bytes);
+  REQUIRE(u32.calls == 2);
+  REQUIRE(u32.bytes == 8);
+  REQUIRE(u32.paths[path(stats_path::scalar)] == 1);
+  REQUIRE(u32.paths[path(stats_path::iterator)] == 1);
+  // u32_to_bytes does not count as i32_to_bytes as well.
+  REQUIRE(delta(stats_function::i32_to_bytes).calls == 0);
+
+  REQUIRE(delta(stats_function::bytes_to_f64).values == 1);
+  REQUIRE(delta(stats_function::bytes_to_u64).calls == 0);
+
+  auto bulk = delta(stats_function::values_to_bytes);
+  REQUIRE(bulk.calls == 2);
+  REQUIRE(bulk.values == 8);
+  REQUIRE(bulk.bytes == 16);
+  REQUIRE(bulk.paths[path(stats_path::bulk_copy)] == 1);
+  REQUIRE(bulk.paths[path(stats_path::bulk_swap)] == 1);
+
+  // The counts of a thread that has exited are kept.
+  REQUIRE(delta(stats_function::i64_to_bytes).calls == 1);
+}
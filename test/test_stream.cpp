@@ -0,0 +1,60 @@
+#include "bit_converter/bit_converter.hpp"
+#include "bit_converter/stream.hpp"
+#include <catch2/catch.hpp>
+
+using std::vector;
+
+TEST_CASE("test stream decoder", "[stream]") {
+  SECTION("value split across chunks") {
+    vector<uint8_t> bytes{0, 1, 112, 148, 255, 255};
+    bit_converter::stream_decoder<int32_t> decoder(true);
+    int32_t values[4];
+    decoder.feed(bytes.data(), 3);
+    REQUIRE(decoder.read(values, 4) == 0);
+    REQUIRE(decoder.is_drained());
+    REQUIRE(decoder.carried_bytes() == 3);
+    decoder.feed(bytes.data() + 3, 3);
+    REQUIRE(decoder.read(values, 4) == 1);
+    REQUIRE(values[0] == 94356);
+    REQUIRE(decoder.carried_bytes() == 2);
+  }
+  SECTION("output smaller than the chunk") {
+    vector<uint8_t> bytes(8 * sizeof(double));
+    for (int i = 0; i < 8; i++) {
+      bit_converter::f64_to_bytes(i * 0.5, false, bytes.begin() + i * 8);
+    }
+    bit_converter::stream_decoder<double> decoder(false);
+    double values[3];
+    decoder.feed(bytes.data(), bytes.size());
+    REQUIRE(decoder.read(values, 3) == 3);
+    REQUIRE_FALSE(decoder.is_drained());
+    REQUIRE(decoder.read(values, 3) == 3);
+    REQUIRE(values[2] == 2.5);
+    REQUIRE(decoder.read(values, 3) == 2);
+    REQUIRE(decoder.is_drained());
+  }
+}
+
+TEST_CASE("test stream decoder with random chunks", "[stream]") {
+  vector<int32_t> values(5000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<int32_t>(i * 2654435761U);
+  }
+  vector<uint8_t> bytes;
+  bit_converter::values_to_bytes(values.data(), values.size(), true,
+                                 std::back_inserter(bytes));
+  bit_converter::stream_decoder<int32_t> decoder(true);
+  vector<int32_t> decoded;
+  int32_t batch[7];
+  size_t offset = 0;
+  for (size_t i = 0; offset < bytes.size(); i++) {
+    size_t size = std::min(bytes.size() - offset, i * 7919 % 23);
+    decoder.consume(bytes.data() + offset, size, batch, 7,
+                    [&](const int32_t *output, size_t count) {
+                      decoded.insert(decoded.end(), output, output + count);
+                    });
+    offset += size;
+  }
+  REQUIRE(decoder.carried_bytes() == 0);
+  REQUIRE(decoded == values);
+}
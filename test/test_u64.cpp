@@ -0,0 +1,17 @@
+#include "bit_converter/bit_converter.hpp"
+#include <catch2/catch.hpp>
+
+using std::vector;
+
+TEST_CASE("test bytes to u64", "[u64]") {
+  auto to_u64 = [](const vector<uint8_t> &bytes,
+                   bool is_big_endian) -> uint64_t {
+    return bit_converter::bytes_to_u64(bytes.begin(), is_big_endian);
+  };
+  SECTION("values above the signed range") {
+    REQUIRE(to_u64(vector<uint8_t>{246, 219, 109, 182, 219, 109, 182, 220},
+                   true) == 17787931785362781916ULL);
+    REQUIRE(to_u64(vector<uint8_t>{220, 182, 109, 219, 182, 109, 219, 246},
+                   false) == 17787931785362781916ULL);
+  }
+}
@@ -0,0 +1,46 @@
+#include "bit_converter/varint.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+using std::vector;
+
+TEST_CASE("test u64 to varint", "[varint]") {
+  auto get_bytes = [](uint64_t value) -> vector<uint8_t> {
+    vector<uint8_t> bytes;
+    bit_converter::u64_to_varint(value, std::back_inserter(bytes));
+    return bytes;
+  };
+  SECTION("one byte") {
+    REQUIRE(get_bytes(0) == vector<uint8_t>{0});
+    REQUIRE(get_bytes(127) == vector<uint8_t>{127});
+  }
+  SECTION("several bytes") {
+    REQUIRE(get_bytes(300) == vector<uint8_t>{172, 2});
+    REQUIRE(get_bytes(UINT64_MAX) ==
+            vector<uint8_t>{255, 255, 255, 255, 255, 255, 255, 255, 255, 1});
+    REQUIRE(bit_converter::varint_size(UINT64_MAX) ==
+            bit_converter::max_varint_size);
+  }
+}
+
+TEST_CASE("test varint to i64", "[varint]") {
+  auto round_trip = [](int64_t value) -> int64_t {
+    vector<uint8_t> bytes;
+    bit_converter::i64_to_varint(value, std::back_inserter(bytes));
+    int64_t result;
+    auto end = bit_converter::varint_to_i64(bytes.begin(), result);
+    REQUIRE(end == bytes.end());
+    return result;
+  };
+  SECTION("zigzag") {
+    REQUIRE(bit_converter::zigzag_encode(0) == 0);
+    REQUIRE(bit_converter::zigzag_encode(-1) == 1);
+    REQUIRE(bit_converter::zigzag_encode(1) == 2);
+    REQUIRE(bit_converter::zigzag_encode(INT64_MIN) == UINT64_MAX);
+  }
+  SECTION("round trip") {
+    REQUIRE(round_trip(-300) == -300);
+    REQUIRE(round_trip(INT64_MAX) == INT64_MAX);
+    REQUIRE(round_trip(INT64_MIN) == INT64_MIN);
+  }
+}
@@ -4,3 +4,41 @@ target("BitConverter")
     set_languages("c++17")
     set_symbols("debug")
     add_files("test/*.cpp")
+
+target("BitConverterCpp20")
+    set_kind("binary")
+    set_default(false)
+    add_includedirs("include/", "libs/")
+    set_languages("c++20")
+    set_symbols("debug")
+    add_files("test/*.cpp")
+
+target("BitConverterStats")
+    set_kind("binary")
+    set_default(false)
+    add_includedirs("include/", "libs/")
+    add_defines("BIT_CONVERTER_ENABLE_STATS")
+    set_languages("c++17")
+    set_symbols("debug")
+    add_files("test/*.cpp")
+
+target("BitConverterNative")
+    set_kind("binary")
+    set_default(false)
+    add_includedirs("include/", "libs/")
+    set_languages("c++17")
+    set_symbols("debug")
+    -- Compile the SSE4.2, AVX2 and BMI2 kernels that the portable targets skip.
+    add_vectorexts("avx2")
+    add_cxflags("-march=native", {tools = {"gcc", "clang"}})
+    add_files("test/*.cpp")
+
+target("Benchmark")
+    set_kind("binary")
+    set_default(false)
+    add_includedirs("include/")
+    set_languages("c++17")
+    set_optimize("fastest")
+    add_vectorexts("avx2")
+    add_cxflags("-march=native", {tools = {"gcc", "clang"}})
+    add_files("bench/*.cpp")